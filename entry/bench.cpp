@@ -0,0 +1,1023 @@
+#include "readdat.h"
+#include "Algorithms/dijkstra.h"
+#include "Algorithms/contraction.h"
+#include "Algorithms/distance_matrix.h"
+#include "Algorithms/bfs.h"
+#include "Algorithms/hub_labels.h"
+#include "Algorithms/bet_cent.h"
+#include "Algorithms/delta_stepping.h"
+#include "Algorithms/shortest_paths.h"
+#include "Algorithms/k_shortest_paths.h"
+#include "Algorithms/hop_limited.h"
+#include "Algorithms/pareto_routes.h"
+#include "Algorithms/range_queries.h"
+#include "Algorithms/direction_bfs.h"
+#include "Algorithms/hop_matrix.h"
+#include "Algorithms/reachability.h"
+#include "Parallel.h"
+#include "SearchWorkspace.h"
+#include "SearchMask.h"
+#include "IntegerGraph.h"
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <limits>
+#include <cstdio>
+#include <thread>
+
+using namespace std;
+
+// Benchmarks for the routing algorithms
+// Usage: ./bench [section] [synthetic airports]
+// where section is one of the names below, or "all" (the default)
+
+// every heap allocation in the program is counted, to check that searches do not allocate
+static atomic<long long> heapAllocations(0);
+
+void* operator new(size_t size) {
+    heapAllocations++;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (!p) { throw bad_alloc(); }
+    return p;
+}
+
+// the replacements pair malloc with free, but once inlined into the standard containers GCC only sees
+// memory from operator new being freed, so its mismatch warning is turned off for them
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { free(p); }
+
+void operator delete(void* p, size_t) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+* @brief Gets the seconds elapsed since a starting time
+*
+* @param start The starting time
+* @return double The seconds elapsed
+*/
+static double secondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+* @brief Picks random pairs of airports with connections to use as queries
+*
+* @param g The graph
+* @param count The number of pairs
+* @param seed The random seed
+* @return vector<pair<int, int>> The source and target IDs
+*/
+static vector<pair<int, int>> randomQueries(const Graph& g, int count, unsigned seed = 42) {
+    vector<int> ids;
+    for (int id : g.getIDs()) {
+        if (!g.getConnections(id, false).empty()) { ids.push_back(id); }
+    }
+    vector<pair<int, int>> queries;
+    if (ids.empty()) { return queries; }
+    mt19937 generator(seed);
+    uniform_int_distribution<int> pick(0, ids.size() - 1);
+    for (int i = 0; i < count; i++) {
+        queries.push_back(make_pair(ids[pick(generator)], ids[pick(generator)]));
+    }
+    return queries;
+}
+
+/**
+* @brief Measures Contraction Hierarchies preprocessing, size and query speed against Dijkstra
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchContraction(const Graph& g, const string& name) {
+    cout << "== Contraction Hierarchies on " << name << " (" << g.size() << " airports, "
+        << g.csr().edges() << " connections) ==" << endl;
+    auto start = chrono::steady_clock::now();
+    ContractionHierarchy ch;
+    ch.build(g);
+    double buildTime = secondsSince(start);
+    cout << "preprocessing: " << buildTime << " s, " << ch.shortcutCount() << " shortcuts, "
+        << ch.hierarchyEdges() << " hierarchy connections" << endl;
+
+    // Dijkstra is slow enough that only the first few queries are timed with it
+    vector<pair<int, int>> queries = randomQueries(g, 1000);
+    vector<pair<int, int>> baseline(queries.begin(), queries.begin() + min((int)queries.size(), 20));
+    start = chrono::steady_clock::now();
+    vector<double> expected;
+    for (auto query : baseline) {
+        Dijkstras dij;
+        dij.getPath(g, query.first, query.second);
+        expected.push_back(dij.shortestDistance());
+    }
+    double dijkstraTime = secondsSince(start) / baseline.size();
+
+    int mismatches = 0;
+    long long settled = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); i++) {
+        ch.getPath(queries[i].first, queries[i].second);
+        settled += ch.settledCount();
+        if (i < expected.size() && !(ch.shortestDistance() == expected[i] || abs(ch.shortestDistance() - expected[i]) < 1e-6)) {
+            mismatches++;
+        }
+    }
+    double chTime = secondsSince(start) / queries.size();
+    cout << "Dijkstra query: " << dijkstraTime * 1e3 << " ms, CH query (with unpacking): " << chTime * 1e3
+        << " ms, speedup " << dijkstraTime / chTime << "x, " << (double)settled / queries.size()
+        << " airports settled per query, " << mismatches << " mismatches" << endl;
+}
+
+/**
+* @brief Gets the airports with the most connections
+*
+* @param g The graph
+* @param count How many airports to get
+* @return vector<int> The IDs of the busiest airports
+*/
+static vector<int> busiestAirports(const Graph& g, int count) {
+    vector<pair<int, int>> degrees;
+    for (int id : g.getIDs()) {
+        degrees.push_back(make_pair(-(int)g.getConnections(id, false).size(), id));
+    }
+    sort(degrees.begin(), degrees.end());
+    vector<int> ids;
+    for (int i = 0; i < count && i < (int)degrees.size(); i++) { ids.push_back(degrees[i].second); }
+    return ids;
+}
+
+/**
+* @brief Measures hub-to-hub distance matrices against one Dijkstra query per pair
+*
+* @param g The graph
+* @param name The name of the graph to print
+* @param hubs How many hub airports to use as both sources and targets
+*/
+static void benchDistanceMatrix(const Graph& g, const string& name, int hubs) {
+    cout << "== " << hubs << " x " << hubs << " distance matrix on " << name << " ==" << endl;
+    vector<int> ids = busiestAirports(g, hubs);
+
+    // pairwise queries are far too slow to run in full, so a sample is timed and scaled up
+    int samples = 20;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+        Dijkstras dij;
+        dij.getPath(g, ids[i % ids.size()], ids[(i * 7 + 3) % ids.size()]);
+    }
+    double pairwiseTime = secondsSince(start) / samples * ids.size() * ids.size();
+    cout << "pairwise Dijkstras::getPath (estimated): " << pairwiseTime << " s" << endl;
+
+    start = chrono::steady_clock::now();
+    DistanceMatrix searches = distanceMatrix(g, ids, ids);
+    double searchTime = secondsSince(start);
+    cout << "one search per source: " << searchTime << " s, speedup " << pairwiseTime / searchTime << "x" << endl;
+
+    start = chrono::steady_clock::now();
+    ContractionHierarchy ch;
+    ch.build(g);
+    double buildTime = secondsSince(start);
+    start = chrono::steady_clock::now();
+    DistanceMatrix buckets = distanceMatrix(ch, ids, ids);
+    double bucketTime = secondsSince(start);
+    int mismatches = 0;
+    for (size_t i = 0; i < searches.getDistances().size(); i++) {
+        double a = searches.getDistances()[i], b = buckets.getDistances()[i];
+        if (!(a == b || abs(a - b) < 1e-6)) { mismatches++; }
+    }
+    cout << "hierarchy buckets: " << bucketTime << " s (plus " << buildTime << " s preprocessing), speedup "
+        << pairwiseTime / bucketTime << "x, " << mismatches << " mismatches" << endl;
+}
+
+/**
+* @brief Measures heap allocations and time per query once the search workspaces are warmed up
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchWorkspace(const Graph& g, const string& name) {
+    cout << "== Search workspaces on " << name << " ==" << endl;
+    vector<pair<int, int>> queries = randomQueries(g, 200);
+    Dijkstras dij;
+    BFS bfs;
+    vector<int> path;
+    // a first pass builds the snapshot and grows the workspace and path to their largest sizes
+    for (auto query : queries) {
+        dij.getPath(g, query.first, query.second, path);
+        bfs.traversalOfBFS(g, query.first);
+    }
+
+    long long before = heapAllocations, workspaceBefore = SearchWorkspace::allocations();
+    auto start = chrono::steady_clock::now();
+    for (auto query : queries) { dij.getPath(g, query.first, query.second, path); }
+    double time = secondsSince(start) / queries.size();
+    cout << "Dijkstra: " << time * 1e3 << " ms per query, "
+        << (double)(heapAllocations - before) / queries.size() << " heap allocations per query" << endl;
+
+    before = heapAllocations;
+    start = chrono::steady_clock::now();
+    for (auto query : queries) { bfs.traversalOfBFS(g, query.first); }
+    time = secondsSince(start) / queries.size();
+    cout << "BFS: " << time * 1e3 << " ms per traversal, " << (double)(heapAllocations - before) / queries.size()
+        << " heap allocations per traversal (the returned copy of the traversal)" << endl;
+    cout << "workspace growth after warm-up: " << SearchWorkspace::allocations() - workspaceBefore << endl;
+}
+
+/**
+* @brief Measures Dijkstra with metre distances and a radix heap against doubles and a binary heap
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchIntegerWeights(const Graph& g, const string& name) {
+    cout << "== Integer distances on " << name << " ==" << endl;
+    IntegerGraph ig(g);
+    cout << "weight array: " << g.csr().edges() * sizeof(double) << " bytes as doubles, "
+        << ig.edges() * sizeof(uint32_t) << " bytes as metres" << endl;
+
+    vector<pair<int, int>> queries = randomQueries(g, 300);
+    Dijkstras dij;
+    vector<int> path;
+    vector<double> expected;
+    // a first pass warms up the workspace for both searches
+    for (auto query : queries) {
+        dij.getPath(g, query.first, query.second, path);
+        dij.getPath(ig, query.first, query.second, path);
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (auto query : queries) {
+        dij.getPath(g, query.first, query.second, path);
+        expected.push_back(dij.shortestDistance());
+    }
+    double doubleTime = secondsSince(start) / queries.size();
+
+    double worstError = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); i++) {
+        dij.getPath(ig, queries[i].first, queries[i].second, path);
+        if (!path.empty()) { worstError = max(worstError, abs(dij.shortestDistance() - expected[i])); }
+    }
+    double integerTime = secondsSince(start) / queries.size();
+    cout << "binary heap: " << doubleTime * 1e3 << " ms per query, radix heap: " << integerTime * 1e3
+        << " ms per query, speedup " << doubleTime / integerTime << "x, largest difference "
+        << worstError * 1000 << " m" << endl;
+}
+
+/**
+* @brief Measures hub label preprocessing, size and query speed with two hub orders
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchHubLabels(const Graph& g, const string& name) {
+    cout << "== Hub labels on " << name << " ==" << endl;
+    vector<pair<int, int>> queries = randomQueries(g, 10000);
+    vector<double> expected;
+    auto start = chrono::steady_clock::now();
+    Dijkstras dij;
+    for (int i = 0; i < 20; i++) {
+        dij.getPath(g, queries[i].first, queries[i].second);
+        expected.push_back(dij.shortestDistance());
+    }
+    double dijkstraTime = secondsSince(start) / expected.size();
+
+    BetweenessCentrality bc;
+    start = chrono::steady_clock::now();
+    map<int, int> scores = bc.getProbabilisticScores(g, 300, true, false);
+    double scoreTime = secondsSince(start);
+
+    for (int order = 0; order < 2; order++) {
+        HubLabels labels;
+        start = chrono::steady_clock::now();
+        if (order == 0) {
+            labels.build(g);
+        } else {
+            labels.build(g, scores);
+        }
+        double buildTime = secondsSince(start) + (order == 1 ? scoreTime : 0);
+
+        int mismatches = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < queries.size(); i++) {
+            double distance = labels.getDistance(queries[i].first, queries[i].second);
+            if (i < expected.size() && !(distance == expected[i] || abs(distance - expected[i]) < 1e-6)) { mismatches++; }
+        }
+        double queryTime = secondsSince(start) / queries.size();
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < 1000; i++) { labels.getPath(queries[i].first, queries[i].second); }
+        double pathTime = secondsSince(start) / 1000;
+
+        cout << (order == 0 ? "degree order" : "betweenness order") << ": preprocessing " << buildTime << " s, "
+            << (double)labels.labelEntries() / labels.size() << " entries per airport, " << labels.bytes() / 1e6
+            << " MB; distance query " << queryTime * 1e6 << " us (Dijkstra " << dijkstraTime * 1e6 << " us, speedup "
+            << dijkstraTime / queryTime << "x), path query " << pathTime * 1e6 << " us, " << mismatches
+            << " mismatches" << endl;
+    }
+}
+
+/**
+* @brief Measures how delta-stepping scales from 1 to 32 threads against a sequential one-to-all Dijkstra
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchDeltaStepping(const Graph& g, const string& name) {
+    cout << "== Delta-stepping on " << name << " (" << defaultThreads() << " hardware threads) ==" << endl;
+    const CSRGraph& csr = g.csr();
+    vector<int> sources;
+    for (auto query : randomQueries(g, 5)) { sources.push_back(csr.getIndex(query.first)); }
+
+    vector<vector<double>> expected(sources.size());
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < sources.size(); i++) { shortestDistances(csr, sources[i], false, expected[i]); }
+    double dijkstraTime = secondsSince(start) / sources.size();
+    cout << "sequential Dijkstra: " << dijkstraTime * 1e3 << " ms per tree" << endl;
+
+    double average = 0;
+    for (int e = 0; e < csr.edges(); e++) { average += csr.weight(e) / csr.edges(); }
+    vector<double> distances;
+    for (double scale : {0.25, 1.0, 4.0}) {
+        cout << "delta " << average * scale << " km:";
+        for (int threads : {1, 2, 4, 8, 16, 32}) {
+            int mismatches = 0;
+            double time = 0;
+            for (size_t i = 0; i < sources.size(); i++) {
+                start = chrono::steady_clock::now();
+                deltaStepping(csr, sources[i], distances, average * scale, threads);
+                time += secondsSince(start);
+                mismatches += distances != expected[i];
+            }
+            cout << " " << threads << " threads " << time / sources.size() * 1e3 << " ms"
+                << (mismatches ? " (MISMATCH)" : "") << ",";
+        }
+        cout << endl;
+    }
+}
+
+/**
+* @brief Measures hop-limited distances from one origin to every airport, for up to 1 to 4 legs
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchHopLimited(const Graph& g, const string& name) {
+    cout << "== Hop-limited paths on " << name << " (" << defaultThreads() << " hardware threads) ==" << endl;
+    const CSRGraph& csr = g.csr();
+    vector<int> sources;
+    for (auto query : randomQueries(g, 5)) { sources.push_back(query.first); }
+
+    vector<double> distances;
+    auto start = chrono::steady_clock::now();
+    for (int source : sources) { shortestDistances(csr, csr.getIndex(source), false, distances); }
+    cout << "sequential Dijkstra (no limit): " << secondsSince(start) / sources.size() * 1e3 << " ms per origin" << endl;
+
+    HopLimitedPaths hops;
+    for (int legs = 1; legs <= 4; legs++) {
+        cout << "at most " << legs << " legs:";
+        for (int threads : {1, 2, 4, 8}) {
+            start = chrono::steady_clock::now();
+            long long reached = 0;
+            for (int source : sources) {
+                hops.build(g, source, legs, threads);
+                const vector<double>& all = hops.getDistances();
+                for (size_t v = legs * csr.size(); v < all.size(); v++) {
+                    reached += all[v] != numeric_limits<double>::infinity();
+                }
+            }
+            cout << " " << threads << " threads " << secondsSince(start) / sources.size() * 1e3 << " ms";
+            if (threads == 1) { cout << " (" << reached / sources.size() << " airports reached)"; }
+            cout << ",";
+        }
+        cout << endl;
+    }
+}
+
+/**
+* @brief Measures Pareto fronts over distance and legs, with at most 6 legs
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchPareto(const Graph& g, const string& name) {
+    cout << "== Pareto fronts on " << name << " ==" << endl;
+    vector<pair<int, int>> queries = randomQueries(g, 1000);
+    Dijkstras dij;
+    vector<int> path;
+    auto start = chrono::steady_clock::now();
+    for (auto query : queries) { dij.getPath(g, query.first, query.second, path); }
+    cout << "Dijkstra: " << secondsSince(start) / queries.size() * 1e3 << " ms per query" << endl;
+
+    ParetoRoutes pareto;
+    long long routes = 0, labels = 0, largest = 0;
+    start = chrono::steady_clock::now();
+    for (auto query : queries) {
+        long long size = pareto.getFront(g, query.first, query.second, 6).size();
+        routes += size;
+        largest = max(largest, size);
+        labels += pareto.labelCount();
+    }
+    double time = secondsSince(start) / queries.size();
+    cout << "Pareto front: " << time * 1e3 << " ms per query, " << (double)routes / queries.size()
+        << " itineraries per front (largest " << largest << "), " << (double)labels / queries.size()
+        << " labels per query" << endl;
+}
+
+/**
+* @brief Measures range queries against a full Dijkstra tree filtered by distance
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchRange(const Graph& g, const string& name) {
+    cout << "== Range queries on " << name << " ==" << endl;
+    const CSRGraph& csr = g.csr();
+    vector<int> sources;
+    for (auto query : randomQueries(g, 200)) { sources.push_back(query.first); }
+
+    vector<double> distances;
+    auto start = chrono::steady_clock::now();
+    for (int source : sources) { shortestDistances(csr, csr.getIndex(source), false, distances); }
+    cout << "full Dijkstra tree: " << secondsSince(start) / sources.size() * 1e3 << " ms per origin" << endl;
+
+    for (double budget : {1000.0, 3000.0, 8000.0}) {
+        long long reached = 0;
+        start = chrono::steady_clock::now();
+        for (int source : sources) { reached += reachableWithin(g, source, budget).size(); }
+        cout << "within " << budget << " km: " << secondsSince(start) / sources.size() * 1e3 << " ms, "
+            << (double)reached / sources.size() << " airports per origin" << endl;
+    }
+    for (int legs : {1, 2, 3}) {
+        long long reached = 0;
+        start = chrono::steady_clock::now();
+        for (int source : sources) { reached += reachableWithinLegs(g, source, legs).size(); }
+        cout << "within " << legs << " legs: " << secondsSince(start) / sources.size() * 1e3 << " ms, "
+            << (double)reached / sources.size() << " airports per origin" << endl;
+    }
+}
+
+/**
+* @brief Measures direction-optimizing BFS against BFS::traversalOfBFS from the busiest airports
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchDirectionBFS(const Graph& g, const string& name) {
+    cout << "== Direction-optimizing BFS on " << name << " ==" << endl;
+    vector<int> sources = busiestAirports(g, 20);
+    BFS bfs;
+    auto start = chrono::steady_clock::now();
+    for (int source : sources) { bfs.traversalOfBFS(g, source); }
+    cout << "BFS::traversalOfBFS: " << secondsSince(start) / sources.size() * 1e3 << " ms" << endl;
+
+    DirectionOptimizingBFS search;
+    for (bool keepOrder : {false, true}) {
+        int topDown = 0, bottomUp = 0;
+        start = chrono::steady_clock::now();
+        for (int source : sources) {
+            search.run(g, source, keepOrder);
+            topDown += search.topDownSteps();
+            bottomUp += search.bottomUpSteps();
+        }
+        cout << "direction-optimizing" << (keepOrder ? " with visiting order" : "") << ": "
+            << secondsSince(start) / sources.size() * 1e3 << " ms, " << (double)topDown / sources.size()
+            << " top-down and " << (double)bottomUp / sources.size() << " bottom-up levels" << endl;
+    }
+}
+
+/**
+* @brief Measures the connected-component labels and how much they save on pairs with no path
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchComponents(const Graph& g, const string& name) {
+    cout << "== Connected components on " << name << " ==" << endl;
+    auto start = chrono::steady_clock::now();
+    CSRGraph csr(g);
+    cout << "snapshot with labels: " << secondsSince(start) * 1e3 << " ms, " << csr.weakComponents() << " weak and "
+        << csr.strongComponents() << " strong components" << endl;
+
+    // pairs of any airports, since those without connections are the ones the labels rule out
+    mt19937 generator(41);
+    uniform_int_distribution<int> pick(0, csr.size() - 1);
+    vector<pair<int, int>> unreachable;
+    int pairs = 2000;
+    for (int i = 0; i < pairs; i++) {
+        int s = pick(generator), t = pick(generator);
+        if (!csr.mayReach(s, t)) { unreachable.push_back(make_pair(s, t)); }
+    }
+    cout << unreachable.size() << " of " << pairs << " random pairs ruled out" << endl;
+    if (unreachable.empty()) { return; }
+
+    // without the labels, Dijkstra only learns there is no path once it has settled everything it can reach
+    vector<double> distances;
+    size_t searched = min<size_t>(unreachable.size(), 200);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < searched; i++) { shortestDistances(g.csr(), unreachable[i].first, false, distances); }
+    cout << "exhaustive search per ruled-out pair: " << secondsSince(start) / searched * 1e3 << " ms" << endl;
+    Dijkstras d;
+    vector<int> path;
+    start = chrono::steady_clock::now();
+    for (const pair<int, int>& query : unreachable) {
+        d.getPath(g, csr.getID(query.first), csr.getID(query.second), path);
+    }
+    cout << "Dijkstras::getPath per ruled-out pair: " << secondsSince(start) / unreachable.size() * 1e6 << " us"
+        << endl;
+}
+
+/**
+* @brief Measures building the reachability index, its size and query latency against a search per query
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchReachability(const Graph& g, const string& name) {
+    cout << "== Reachability index on " << name << " (" << g.size() << " airports) ==" << endl;
+    g.csr();
+    auto start = chrono::steady_clock::now();
+    ReachabilityIndex index;
+    index.build(g);
+    cout << "build: " << secondsSince(start) * 1e3 << " ms, " << index.components() << " components, "
+        << index.intervals() << " intervals, " << index.bytes() / 1024.0 / 1024.0 << " MB ("
+        << (double)index.bytes() / g.size() << " bytes per airport)" << endl;
+
+    const CSRGraph& csr = g.csr();
+    mt19937 generator(42);
+    uniform_int_distribution<int> pick(0, csr.size() - 1);
+    vector<pair<int, int>> queries;
+    for (int i = 0; i < 1000000; i++) { queries.push_back(make_pair(pick(generator), pick(generator))); }
+    long long reachable = 0;
+    start = chrono::steady_clock::now();
+    for (const pair<int, int>& query : queries) { reachable += index.reachesIndex(query.first, query.second); }
+    double indexTime = secondsSince(start) / queries.size();
+    cout << "index query: " << indexTime * 1e9 << " ns (" << reachable * 100.0 / queries.size() << "% reachable)"
+        << endl;
+
+    // without the index, a query is a search until the target is found or everything reachable is settled
+    BFS bfs;
+    size_t searched = 50;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < searched; i++) { bfs.traversalOfBFS(g, csr.getID(queries[i].first)); }
+    cout << "BFS per query: " << secondsSince(start) / searched * 1e6 << " us" << endl;
+}
+
+/**
+* @brief Measures Brandes' betweenness against the original search per pair of airports
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchBetweenness(const Graph& g, const string& name) {
+    cout << "== Betweenness centrality on " << name << " (" << g.size() << " airports, " << defaultThreads()
+        << " hardware threads) ==" << endl;
+    const vector<int>& ids = g.csr().getIDs();
+    // a search per ordered pair, as getAllScores used to run, timed over a few sources
+    Dijkstras d;
+    vector<int> path;
+    int sources = 3;
+    auto start = chrono::steady_clock::now();
+    for (int s = 0; s < sources; s++) {
+        for (int target : ids) { d.getPath(g, ids[s * ids.size() / sources], target, path); }
+    }
+    cout << "search per pair: about " << secondsSince(start) / sources * ids.size() << " s in total (estimated)"
+        << endl;
+
+    BetweenessCentrality bc;
+    // scaling with threads, checking the scores do not change at all
+    map<int, double> serial;
+    double serialTime = 0;
+    for (int threads : {1, 2, 4, 8, 16, 32, 64}) {
+        start = chrono::steady_clock::now();
+        map<int, double> scores = bc.getBrandesScores(g, true, false, false, threads);
+        double seconds = secondsSince(start);
+        if (threads == 1) {
+            serial = scores;
+            serialTime = seconds;
+        }
+        cout << "Brandes with " << threads << " threads: " << seconds << " s (" << serialTime / seconds << "x), "
+            << (scores == serial ? "identical" : "DIFFERENT") << " scores" << endl;
+    }
+    for (int mode = 1; mode < 3; mode++) {
+        start = chrono::steady_clock::now();
+        map<int, double> scores = bc.getBrandesScores(g, mode != 2, mode == 1);
+        double seconds = secondsSince(start);
+        auto top = max_element(scores.begin(), scores.end(), [](const pair<const int, double>& a,
+            const pair<const int, double>& b) { return a.second < b.second; });
+        cout << (mode == 0 ? "Brandes by distance" : mode == 1 ? "Brandes, one path per pair" : "Brandes by legs")
+            << ": " << seconds << " s, top airport " << top->first << " (" << top->second << ")" << endl;
+    }
+}
+
+/**
+* @brief Measures approximate betweenness against exact Brandes, checking the error bound
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchApproximateBetweenness(const Graph& g, const string& name) {
+    cout << "== Approximate betweenness on " << name << " ==" << endl;
+    BetweenessCentrality bc;
+    auto start = chrono::steady_clock::now();
+    map<int, double> exact = bc.getBrandesScores(g);
+    cout << "exact Brandes: " << secondsSince(start) << " s" << endl;
+    vector<pair<double, int>> ranked;
+    for (auto score : exact) { ranked.push_back(make_pair(-score.second, score.first)); }
+    sort(ranked.begin(), ranked.end());
+
+    double pairs = (double)g.size() * (g.size() - 1);
+    for (double epsilon : {0.01, 0.005, 0.0025}) {
+        start = chrono::steady_clock::now();
+        map<int, double> estimate = bc.getApproximateScores(g, epsilon, 0.1);
+        double seconds = secondsSince(start);
+        double worst = 0;
+        for (auto score : estimate) { worst = max(worst, abs(score.second - exact[score.first]) / pairs); }
+        // how many of the exact top 20 the estimate also ranks in its top 20
+        vector<pair<double, int>> estimated;
+        for (auto score : estimate) { estimated.push_back(make_pair(-score.second, score.first)); }
+        sort(estimated.begin(), estimated.end());
+        int overlap = 0;
+        for (int i = 0; i < 20; i++) {
+            for (int j = 0; j < 20; j++) { overlap += ranked[i].second == estimated[j].second; }
+        }
+        cout << "epsilon " << epsilon << ": " << seconds << " s, " << bc.samplesTaken() << " samples, largest error "
+            << worst << ", " << overlap << " of the top 20" << endl;
+    }
+}
+
+/**
+* @brief Follows ProgressiveBetweenness while it runs, comparing each snapshot with exact Brandes scores
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchProgressiveBetweenness(const Graph& g, const string& name) {
+    cout << "== Progressive betweenness on " << name << " ==" << endl;
+    BetweenessCentrality bc;
+    auto start = chrono::steady_clock::now();
+    map<int, double> exact = bc.getBrandesScores(g, true, false, false, 1);
+    cout << "exact Brandes, 1 thread: " << secondsSince(start) << " s" << endl;
+    vector<pair<double, int>> ranked;
+    for (auto score : exact) { ranked.push_back(make_pair(-score.second, score.first)); }
+    sort(ranked.begin(), ranked.end());
+
+    ProgressiveBetweenness progressive(g);
+    start = chrono::steady_clock::now();
+    progressive.start(1);
+    int last = -1;
+    while (true) {
+        shared_ptr<const CentralitySnapshot> snapshot = progressive.snapshot();
+        if (snapshot->sources != last && snapshot->sources > 0) {
+            last = snapshot->sources;
+            int overlap = 0;
+            double widest = 0;
+            for (int i = 0; i < 20; i++) {
+                widest = max(widest, snapshot->ranking[i].margin);
+                for (int j = 0; j < 20; j++) { overlap += ranked[i].second == snapshot->ranking[j].id; }
+            }
+            cout << secondsSince(start) << " s: " << snapshot->sources << " of " << snapshot->totalSources
+                << " sources, " << overlap << " of the top 20, widest top-20 margin " << widest << endl;
+        }
+        if (progressive.finished() && snapshot->sources == snapshot->totalSources) { break; }
+        this_thread::sleep_for(chrono::milliseconds(250));
+    }
+    progressive.wait();
+}
+
+/**
+* @brief Measures DynamicBetweenness' single-route updates against recomputing every score
+*
+* @param g The graph (copied, since routes are added and cut)
+* @param name The name of the graph to print
+*/
+static void benchDynamicBetweenness(const Graph& g, const string& name) {
+    cout << "== Dynamic betweenness on " << name << " ==" << endl;
+    Graph changed = g;
+    DynamicBetweenness dynamic;
+    auto start = chrono::steady_clock::now();
+    dynamic.build(changed);
+    double full = secondsSince(start);
+    cout << "build: " << full << " s, " << dynamic.bytes() / 1e6 << " MB" << endl;
+
+    // routes between airports that already have some, as new services would be
+    mt19937 rng(49);
+    vector<int> served;
+    for (int id : changed.getIDs()) {
+        if (!changed.getConnections(id).empty()) { served.push_back(id); }
+    }
+    for (bool adding : {false, true}) {
+        double seconds = 0;
+        long long sources = 0;
+        int updates = 0;
+        while (updates < 20) {
+            int from = served[rng() % served.size()];
+            vector<int> routes = changed.getConnections(from);
+            int to = adding ? served[rng() % served.size()] : routes[rng() % routes.size()];
+            start = chrono::steady_clock::now();
+            bool done = adding ? dynamic.connect(changed, from, to) : dynamic.disconnect(changed, from, to);
+            seconds += secondsSince(start);
+            if (done) {
+                updates++;
+                sources += dynamic.sourcesUpdated();
+            }
+        }
+        cout << (adding ? "adding" : "cutting") << " a route: " << seconds / updates * 1e3 << " ms, "
+            << (double)sources / updates << " of " << changed.size() << " sources searched ("
+            << full / (seconds / updates) << "x faster than recomputing)" << endl;
+    }
+
+    BetweenessCentrality bc;
+    map<int, double> exact = bc.getBrandesScores(changed);
+    double worst = 0;
+    for (auto score : exact) {
+        worst = max(worst, abs(dynamic.getScore(score.first) - score.second) / max(1.0, score.second));
+    }
+    cout << "largest relative difference from recomputing: " << worst << endl;
+}
+
+/**
+* @brief Measures certified top-k rankings against computing every score
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchTopBetweenness(const Graph& g, const string& name) {
+    cout << "== Top-k betweenness on " << name << " ==" << endl;
+    BetweenessCentrality bc;
+    auto start = chrono::steady_clock::now();
+    map<int, double> exact = bc.getBrandesScores(g);
+    double full = secondsSince(start);
+    cout << "exact Brandes: " << full << " s" << endl;
+    vector<pair<double, int>> ranked;
+    for (auto score : exact) { ranked.push_back(make_pair(-score.second, score.first)); }
+    sort(ranked.begin(), ranked.end());
+
+    for (int k : {10, 50}) {
+        for (double epsilon : {0.0, 0.001, 0.002, 0.005}) {
+            start = chrono::steady_clock::now();
+            vector<CentralityEstimate> top = bc.getTopScores(g, k, epsilon, 0.1);
+            double seconds = secondsSince(start);
+            // how many places hold the same airport as the exact ranking
+            int same = 0;
+            for (int i = 0; i < k; i++) { same += top[i].id == ranked[i].second; }
+            cout << "top " << k << ", epsilon " << epsilon << ": " << seconds << " s (" << full / seconds
+                << "x faster), " << bc.sourcesSearched() << " of " << g.size() << " sources, " << same << " of "
+                << k << " places exact" << endl;
+        }
+    }
+}
+
+/**
+* @brief Measures small-radius neighbourhood queries against a full BFS::traversalOfBFS
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchNeighbourhood(const Graph& g, const string& name) {
+    cout << "== k-hop neighbourhoods on " << name << " ==" << endl;
+    vector<pair<int, int>> queries = randomQueries(g, 200);
+    BFS bfs;
+    g.csr();
+    auto start = chrono::steady_clock::now();
+    for (const pair<int, int>& query : queries) { bfs.traversalOfBFS(g, query.first); }
+    cout << "BFS::traversalOfBFS: " << secondsSince(start) / queries.size() * 1e6 << " us" << endl;
+    for (int maxLegs : {1, 2, 3}) {
+        size_t found = 0;
+        start = chrono::steady_clock::now();
+        for (const pair<int, int>& query : queries) { found += bfs.neighbourhood(g, query.first, maxLegs).size(); }
+        cout << "within " << maxLegs << " legs: " << secondsSince(start) / queries.size() * 1e6 << " us, "
+            << (double)found / queries.size() << " airports" << endl;
+    }
+}
+
+/**
+* @brief Measures the level-synchronous parallel BFS against BFS::traversalOfBFS
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchParallelBFS(const Graph& g, const string& name) {
+    cout << "== Parallel BFS on " << name << " (" << defaultThreads() << " hardware threads) ==" << endl;
+    vector<int> sources = busiestAirports(g, 10);
+    BFS bfs;
+    g.csr();
+    auto start = chrono::steady_clock::now();
+    for (int source : sources) { bfs.traversalOfBFS(g, source); }
+    double sequential = secondsSince(start) / sources.size();
+    cout << "BFS::traversalOfBFS: " << sequential * 1e3 << " ms" << endl;
+    for (int threads : {1, 2, 4, 8}) {
+        start = chrono::steady_clock::now();
+        for (int source : sources) { bfs.parallelTraversalOfBFS(g, source, threads); }
+        double parallel = secondsSince(start) / sources.size();
+        cout << "parallelTraversalOfBFS with " << threads << " threads: " << parallel * 1e3 << " ms ("
+            << sequential / parallel << "x)" << endl;
+    }
+}
+
+/**
+* @brief Measures the all-pairs hop matrix against one BFS per airport, and writing it to a file
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchHopMatrix(const Graph& g, const string& name) {
+    cout << "== All-pairs hop matrix on " << name << " (" << defaultThreads() << " hardware threads) ==" << endl;
+    vector<int> ids = g.getIDs();
+    BFS bfs;
+    auto start = chrono::steady_clock::now();
+    int sampled = min((int)ids.size(), 500);
+    for (int i = 0; i < sampled; i++) { bfs.traversalOfBFS(g, ids[i * ids.size() / sampled]); }
+    cout << "one BFS::traversalOfBFS per airport: " << secondsSince(start) / sampled * ids.size() << " s (estimated from "
+        << sampled << " airports)" << endl;
+
+    HopMatrix matrix;
+    for (int threads : {1, defaultThreads()}) {
+        start = chrono::steady_clock::now();
+        matrix.build(g, threads);
+        cout << "bit-parallel, " << threads << " threads: " << secondsSince(start) << " s" << endl;
+    }
+    const HopStats& stats = matrix.getStats();
+    cout << "diameter " << stats.diameter << " legs, " << stats.averageHops << " legs on average over "
+        << stats.connectedPairs << " connected pairs" << endl;
+
+    start = chrono::steady_clock::now();
+    string filename = "bench_hop_matrix.bin";
+    HopMatrix::write(g, filename, 0);
+    cout << "streamed to disk: " << secondsSince(start) << " s for " << (double)ids.size() * ids.size() / 1e6 << " MB" << endl;
+    remove(filename.c_str());
+}
+
+/**
+* @brief Measures k = 10 shortest paths between airports more than 8000 km apart
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchKShortestPaths(const Graph& g, const string& name) {
+    cout << "== 10 shortest paths on " << name << " ==" << endl;
+    const CSRGraph& csr = g.csr();
+    vector<pair<int, int>> queries;
+    for (auto query : randomQueries(g, 5000)) {
+        if (queries.size() < 100 && csr.straightDistance(csr.getIndex(query.first), csr.getIndex(query.second)) > 8000) {
+            queries.push_back(query);
+        }
+    }
+    KShortestPaths ksp;
+    long long paths = 0, searches = 0;
+    auto start = chrono::steady_clock::now();
+    for (auto query : queries) {
+        paths += ksp.getPaths(g, query.first, query.second, 10).size();
+        searches += ksp.searchCount();
+    }
+    double time = secondsSince(start) / queries.size();
+    cout << queries.size() << " intercontinental queries: " << time * 1e3 << " ms per query, "
+        << (double)paths / queries.size() << " paths and " << (double)searches / queries.size()
+        << " spur searches per query (the rest reused the shortest path tree)" << endl;
+}
+
+/**
+* @brief Measures what-if queries around a closed hub: copying the graph and removing the hub, against a SearchMask
+*
+* @param g The graph
+* @param name The name of the graph to print
+*/
+static void benchWhatIf(const Graph& g, const string& name) {
+    cout << "== closed-hub queries on " << name << " ==" << endl;
+    vector<pair<int, int>> queries = randomQueries(g, 200);
+    int hub = busiestAirports(g, 1)[0];
+    Dijkstras dij;
+    vector<int> path;
+
+    auto start = chrono::steady_clock::now();
+    for (auto query : queries) { dij.getPath(g, query.first, query.second, path); }
+    double plain = secondsSince(start) / queries.size();
+
+    start = chrono::steady_clock::now();
+    vector<double> copyDistances;
+    for (auto query : queries) {
+        Graph closed = g;
+        closed.removeNode(hub);
+        dij.getPath(closed, query.first, query.second, path);
+        copyDistances.push_back(path.empty() ? -1 : dij.shortestDistance());
+    }
+    double copied = secondsSince(start) / queries.size();
+
+    int mismatches = 0;
+
+    // each query sets up its own bans, in a mask reused between queries as a server would
+    SearchMask mask;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); i++) {
+        const CSRGraph& csr = g.csr();
+        mask.clear(csr);
+        mask.banAirport(csr, hub);
+        dij.getPath(g, queries[i].first, queries[i].second, path, &mask);
+        mismatches += (path.empty() ? -1 : dij.shortestDistance()) != copyDistances[i];
+    }
+    double masked = secondsSince(start) / queries.size();
+    cout << "closing " << g.getName(hub) << ": plain query " << plain * 1e3 << " ms, copy and remove "
+        << copied * 1e3 << " ms, mask " << masked * 1e3 << " ms" << (mismatches ? " (MISMATCH)" : "") << endl;
+}
+
+int main(int argc, char** argv) {
+    string section = argc > 1 ? argv[1] : "all";
+    int syntheticSize = argc > 2 ? atoi(argv[2]) : 20000;
+    auto runs = [&](const string& name) { return section == "all" || section == name; };
+
+    Graph g = readData("../Data/airports.dat",  "../Data/routes.dat");
+    auto start = chrono::steady_clock::now();
+    Graph synthetic = syntheticData(syntheticSize);
+    cout << "generated " << syntheticSize << " synthetic airports in " << secondsSince(start) << " s" << endl;
+
+    if (runs("ch")) {
+        benchContraction(g, "OpenFlights");
+        benchContraction(synthetic, "synthetic network");
+    }
+    if (runs("workspace")) {
+        benchWorkspace(g, "OpenFlights");
+        benchWorkspace(synthetic, "synthetic network");
+    }
+    if (runs("integer")) {
+        benchIntegerWeights(g, "OpenFlights");
+        benchIntegerWeights(synthetic, "synthetic network");
+    }
+    if (runs("labels")) {
+        benchHubLabels(g, "OpenFlights");
+        benchHubLabels(synthetic, "synthetic network");
+    }
+    if (runs("delta")) {
+        benchDeltaStepping(g, "OpenFlights");
+        benchDeltaStepping(synthetic, "synthetic network");
+    }
+    if (runs("kpaths")) {
+        benchKShortestPaths(g, "OpenFlights");
+        benchKShortestPaths(synthetic, "synthetic network");
+    }
+    if (runs("whatif")) {
+        benchWhatIf(g, "OpenFlights");
+        benchWhatIf(synthetic, "synthetic network");
+    }
+    if (runs("hops")) {
+        benchHopLimited(g, "OpenFlights");
+        benchHopLimited(synthetic, "synthetic network");
+    }
+    if (runs("pareto")) {
+        benchPareto(g, "OpenFlights");
+        benchPareto(synthetic, "synthetic network");
+    }
+    if (runs("range")) {
+        benchRange(g, "OpenFlights");
+        benchRange(synthetic, "synthetic network");
+    }
+    if (runs("dobfs")) {
+        benchDirectionBFS(g, "OpenFlights");
+        benchDirectionBFS(synthetic, "synthetic network");
+    }
+    if (runs("brandes")) {
+        // a search from every airport of the synthetic network would take minutes at its default size
+        benchBetweenness(g, "OpenFlights");
+    }
+    if (runs("approx")) {
+        benchApproximateBetweenness(g, "OpenFlights");
+    }
+    if (runs("progressive")) {
+        benchProgressiveBetweenness(g, "OpenFlights");
+    }
+    if (runs("dynamic")) {
+        benchDynamicBetweenness(g, "OpenFlights");
+    }
+    if (runs("topk")) {
+        benchTopBetweenness(g, "OpenFlights");
+    }
+    if (runs("khop")) {
+        benchNeighbourhood(g, "OpenFlights");
+        benchNeighbourhood(synthetic, "synthetic network");
+    }
+    if (runs("pbfs")) {
+        benchParallelBFS(g, "OpenFlights");
+        benchParallelBFS(synthetic, "synthetic network");
+    }
+    if (runs("components")) {
+        benchComponents(g, "OpenFlights");
+        benchComponents(synthetic, "synthetic network");
+    }
+    if (runs("reach")) {
+        benchReachability(g, "OpenFlights");
+        benchReachability(synthetic, "synthetic network");
+    }
+    if (runs("hopmatrix")) {
+        // the synthetic network's matrix would not fit in memory at its default size
+        benchHopMatrix(g, "OpenFlights");
+    }
+    if (runs("matrix")) {
+        benchDistanceMatrix(g, "OpenFlights", 300);
+        benchDistanceMatrix(synthetic, "synthetic network", 300);
+    }
+}
@@ -3,17 +3,42 @@
 #include "Algorithms/bfs.h"
 #include "Algorithms/bet_cent.h"
 #include "Algorithms/makeimage.h"
+#include "Algorithms/batch_queries.h"
+
+#include <string>
+#include <cstdlib>
 
 using namespace std;
 using cs225::PNG;
 using cs225::HSLAPixel;
 
-int main() {
+int main(int argc, char** argv) {
     // example usage
     Graph g = readData("../Data/airports.dat",  "../Data/routes.dat");
 
     cout << g.size() << " airports and " << g.connections() << " connections" << endl;
 
+    // batch mode: ./main batch <queries file> <results file (.csv, or .bin for binary)> [threads]
+    if (argc >= 4 && string(argv[1]) == "batch") {
+        vector<pair<int, int>> queries;
+        if (!readQueries(argv[2], queries)) {
+            cout << "could not read " << argv[2] << endl;
+            return 1;
+        }
+        string output = argv[3];
+        bool binary = output.size() >= 4 && output.substr(output.size() - 4) == ".bin";
+        int threads = argc > 4 ? atoi(argv[4]) : 0;
+        BatchSummary summary;
+        if (!runBatch(g, queries, output, binary, threads, &summary)) {
+            cout << "could not write " << output << endl;
+            return 1;
+        }
+        cout << summary.queries << " queries from " << summary.sources << " sources (" << summary.unreachable
+            << " without a path) in " << summary.seconds << " s: " << summary.queriesPerSecond()
+            << " queries per second" << endl;
+        return 0;
+    }
+
     int source = 3319;
     int target = 5554;
     PNG worldMap;
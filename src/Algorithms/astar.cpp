@@ -0,0 +1,83 @@
+#include "astar.h"
+#include <queue>
+#include <algorithm>
+
+using namespace std;
+
+// shrinks straight-line bounds slightly so rounding never makes them overestimate
+static const double STRAIGHT_LINE_SCALE = 1 - 1e-9;
+
+vector<int> AStar::getPath(const Graph& g, int source, int target, const SearchMask* mask) {
+    double inf = numeric_limits<double>::infinity();
+    shortestDistance_ = inf;
+    settled_ = 0;
+    const CSRGraph& csr = g.csr();
+    int s = csr.getIndex(source);
+    int t = csr.getIndex(target);
+    // checks if source and targets are valid, and that the components allow a path at all
+    if (s == -1 || t == -1 || !csr.mayReach(s, t) || (mask && (mask->nodeBanned(s) || mask->nodeBanned(t)))) {
+        return vector<int>();
+    }
+
+    bool useLandmarks = landmarks_ && landmarks_->matches(csr);
+    vector<int> active;
+    if (useLandmarks && maxActive_ > 0) {
+        active = landmarks_->activeLandmarks(s, t, maxActive_);
+    }
+    int n = csr.size();
+    vector<double> dist(n, inf);
+    vector<double> bound(n, -1); // the heuristic of each airport, computed when first reached
+    vector<int> prev(n, -1);
+    auto heuristic = [&](int v) {
+        if (bound[v] < 0) {
+            double h = csr.straightDistance(v, t) * STRAIGHT_LINE_SCALE;
+            if (useLandmarks) {
+                h = max(h, maxActive_ > 0 ? landmarks_->lowerBound(v, t, active) : landmarks_->lowerBound(v, t));
+            }
+            bound[v] = h;
+        }
+        return bound[v];
+    };
+
+    struct QueueNode {
+        double estimate, distance;
+        int index;
+        bool operator>(const QueueNode& other) const { return estimate > other.estimate; }
+    };
+    priority_queue<QueueNode, vector<QueueNode>, greater<QueueNode>> qu;
+    dist[s] = 0;
+    qu.push(QueueNode{heuristic(s), 0, s});
+
+    while (!qu.empty()) {
+        QueueNode node = qu.top();
+        qu.pop();
+        // skips stale queue entries (airports may be reopened if rounding made a bound inconsistent)
+        if (node.distance > dist[node.index]) { continue; }
+        settled_++;
+        if (node.index == t) { break; }
+        for (int e = csr.outBegin(node.index); e < csr.outEnd(node.index); e++) {
+            int v = csr.target(e);
+            if (mask && (mask->edgeBanned(e) || mask->nodeBanned(v))) { continue; }
+            double alt = node.distance + csr.weight(e);
+            if (alt < dist[v]) {
+                double h = heuristic(v);
+                // the bounds prove the target cannot be reached from v
+                if (h == inf) { continue; }
+                dist[v] = alt;
+                prev[v] = node.index;
+                qu.push(QueueNode{alt + h, alt, v});
+            }
+        }
+    }
+
+    if (dist[t] == inf) {
+        return vector<int>();
+    }
+    shortestDistance_ = dist[t];
+    vector<int> path;
+    for (int v = t; v != -1; v = prev[v]) {
+        path.push_back(csr.getID(v));
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
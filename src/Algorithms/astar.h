@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+#include "../SearchMask.h"
+#include "landmarks.h"
+
+#include <vector>
+#include <limits>
+
+using namespace std;
+
+/**
+ * Class for A* search
+ * Finds the same shortest paths as Dijkstras, but directs the search towards the target
+ * using a lower bound on the remaining distance. The straight-line distance to the target is
+ * always used, and precomputed Landmarks tighten the bound further when given
+ */
+class AStar {
+    public:
+        /**
+        * @brief Constructs an A* search guided by straight-line distances only
+        */
+        AStar() : landmarks_(nullptr), maxActive_(0),
+            shortestDistance_(numeric_limits<double>::infinity()), settled_(0) {}
+
+        /**
+        * @brief Constructs an A* search that is also guided by landmark bounds (ALT)
+        * The landmarks are ignored for graphs they were not built for
+        *
+        * @param landmarks The landmark tables (must outlive this object)
+        * @param maxActive How many of the landmarks to use per query (0 to use all of them)
+        */
+        AStar(const Landmarks& landmarks, int maxActive = 4) : landmarks_(&landmarks), maxActive_(maxActive),
+            shortestDistance_(numeric_limits<double>::infinity()), settled_(0) {}
+
+        /**
+        * @brief Generates the shortest path of airports from source to target
+        * @param g network of all airports
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all);
+        * the bounds stay valid since avoiding parts of the graph only makes paths longer
+        * @return chronological vector of airport IDs from source to target (empty if there is no path)
+        */
+        vector<int> getPath(const Graph& g, int source, int target, const SearchMask* mask = nullptr);
+
+        /**
+        * @brief shortest distance of the last query
+        * @return The distance between the airports, or infinity if there is no path
+        */
+        double shortestDistance() const {
+            return shortestDistance_;
+        }
+
+        /**
+        * @brief number of airports settled by the last query, which measures how focused the search was
+        * @return The number of settled airports
+        */
+        int settledCount() const {
+            return settled_;
+        }
+
+    private:
+        /**
+        * @brief landmark tables used for bounds, or null for straight-line bounds only
+        */
+        const Landmarks* landmarks_;
+        /**
+        * @brief how many landmarks are used per query (0 for all)
+        */
+        int maxActive_;
+        /**
+        * @brief shortest distance of the last query
+        */
+        double shortestDistance_;
+        /**
+        * @brief airports settled by the last query
+        */
+        int settled_;
+};
@@ -0,0 +1,179 @@
+#include "batch_queries.h"
+#include "../CSRGraph.h"
+#include "../SearchWorkspace.h"
+#include "../Parallel.h"
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+using namespace std;
+
+bool readQueries(const string& filename, vector<pair<int, int>>& queries) {
+    ifstream in(filename);
+    if (!in) { return false; }
+    queries.clear();
+    string line;
+    while (getline(in, line)) {
+        replace(line.begin(), line.end(), ',', ' ');
+        istringstream fields(line);
+        int source, target;
+        if (fields >> source >> target) {
+            queries.push_back(make_pair(source, target));
+        }
+    }
+    return true;
+}
+
+/**
+* @brief Answers one group of queries with a single search from their shared source
+*
+* @param csr The snapshot to search
+* @param queries Every query of the batch
+* @param group The positions of the group's queries
+* @param results Filled with the group's results
+*/
+static void answerGroup(const CSRGraph& csr, const vector<pair<int, int>>& queries, const vector<int>& group,
+    vector<RouteResult>& results) {
+    results.clear();
+    int s = csr.getIndex(queries[group[0]].first);
+    vector<int> targets; // the dense indices still to be settled, sorted
+    for (int query : group) {
+        int t = csr.getIndex(queries[query].second);
+        // targets the source cannot reach would make the search run to exhaustion
+        if (t != -1 && s != -1 && csr.mayReach(s, t)) { targets.push_back(t); }
+    }
+    sort(targets.begin(), targets.end());
+    targets.erase(unique(targets.begin(), targets.end()), targets.end());
+    size_t remaining = s == -1 ? 0 : targets.size();
+
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.reset(csr.size());
+    if (s != -1) {
+        vector<pair<double, int>>& qu = ws.heap();
+        ws.reach(s, 0, -1);
+        qu.push_back(make_pair(0.0, s));
+        while (!qu.empty() && remaining > 0) {
+            pair<double, int> node = qu.front();
+            pop_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+            qu.pop_back();
+            int v = node.second;
+            if (ws.visited(v)) { continue; }
+            ws.visit(v);
+            if (binary_search(targets.begin(), targets.end(), v)) { remaining--; }
+            for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+                int adj = csr.target(e);
+                double alt = node.first + csr.weight(e);
+                if (alt < ws.distance(adj)) {
+                    ws.reach(adj, alt, v);
+                    qu.push_back(make_pair(alt, adj));
+                    push_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+                }
+            }
+        }
+    }
+
+    for (int query : group) {
+        RouteResult result;
+        result.query = query;
+        result.source = queries[query].first;
+        result.target = queries[query].second;
+        result.distance = numeric_limits<double>::infinity();
+        int t = csr.getIndex(result.target);
+        if (s != -1 && t != -1 && ws.visited(t)) {
+            result.distance = ws.distance(t);
+            for (int v = t; v != -1; v = ws.parent(v)) { result.path.push_back(csr.getID(v)); }
+            reverse(result.path.begin(), result.path.end());
+        }
+        results.push_back(std::move(result));
+    }
+}
+
+BatchSummary routeBatch(const Graph& g, const vector<pair<int, int>>& queries, int threads,
+    const function<void(const vector<RouteResult>&)>& sink) {
+    auto start = chrono::steady_clock::now();
+    BatchSummary summary;
+    summary.queries = queries.size();
+    const CSRGraph& csr = g.csr();
+
+    // groups the queries by source, keeping each group in batch order
+    vector<int> order(queries.size());
+    for (size_t i = 0; i < order.size(); i++) { order[i] = i; }
+    stable_sort(order.begin(), order.end(), [&](int a, int b) { return queries[a].first < queries[b].first; });
+    vector<vector<int>> groups;
+    for (size_t i = 0; i < order.size(); i++) {
+        if (i == 0 || queries[order[i]].first != queries[order[i - 1]].first) { groups.push_back(vector<int>()); }
+        groups.back().push_back(order[i]);
+    }
+    summary.sources = groups.size();
+
+    mutex sinkMutex;
+    {
+        ThreadPool pool(threads);
+        for (const vector<int>& group : groups) {
+            pool.submit([&] {
+                vector<RouteResult> results;
+                answerGroup(csr, queries, group, results);
+                long long unreachable = 0;
+                for (const RouteResult& result : results) { unreachable += result.path.empty(); }
+                lock_guard<mutex> lock(sinkMutex);
+                summary.unreachable += unreachable;
+                sink(results);
+            });
+        }
+        pool.wait();
+    }
+    summary.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+bool runBatch(const Graph& g, const vector<pair<int, int>>& queries, const string& filename, bool binary,
+    int threads, BatchSummary* summary) {
+    ofstream out(filename, binary ? ios::binary : ios::out);
+    if (!out) { return false; }
+    if (binary) {
+        out.write("ROUTES01", 8);
+    } else {
+        out << "query,source,target,distance,hops,path\n";
+    }
+
+    // each group is formatted into one buffer, so the file is written in a few large pieces
+    string buffer;
+    BatchSummary totals = routeBatch(g, queries, threads, [&](const vector<RouteResult>& results) {
+        buffer.clear();
+        for (const RouteResult& result : results) {
+            int32_t hops = (int32_t)result.path.size() - 1;
+            if (binary) {
+                int32_t fields[3] = {result.query, result.source, result.target};
+                buffer.append((const char*)fields, sizeof(fields));
+                buffer.append((const char*)&result.distance, sizeof(result.distance));
+                buffer.append((const char*)&hops, sizeof(hops));
+                for (int id : result.path) {
+                    int32_t id32 = id;
+                    buffer.append((const char*)&id32, sizeof(id32));
+                }
+            } else {
+                ostringstream line;
+                line.precision(17);
+                line << result.query << ',' << result.source << ',' << result.target << ',';
+                if (result.path.empty()) {
+                    line << "inf";
+                } else {
+                    line << result.distance;
+                }
+                line << ',' << hops << ',';
+                for (size_t i = 0; i < result.path.size(); i++) { line << (i ? " " : "") << result.path[i]; }
+                line << '\n';
+                buffer += line.str();
+            }
+        }
+        out.write(buffer.data(), buffer.size());
+    });
+    out.flush();
+    if (summary) { *summary = totals; }
+    return (bool)out;
+}
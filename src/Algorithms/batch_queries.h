@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../Graph.h"
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <functional>
+
+using namespace std;
+
+/**
+ * @brief The answer to one query of a batch
+ */
+struct RouteResult {
+    int query; // the query's position in the batch
+    int source, target; // the airport IDs
+    double distance; // infinity if there is no path
+    vector<int> path; // chronological airport IDs from source to target (empty if there is no path)
+};
+
+/**
+ * @brief Totals for a batch of queries
+ */
+struct BatchSummary {
+    long long queries = 0;
+    long long unreachable = 0; // queries with no path (including airports not in the graph)
+    int sources = 0; // the number of distinct sources, which is the number of searches run
+    double seconds = 0;
+
+    /**
+    * @brief Gets the throughput of the batch
+    * @return The queries answered per second
+    */
+    double queriesPerSecond() const { return seconds > 0 ? queries / seconds : 0; }
+};
+
+/**
+* @brief Reads origin/destination pairs from a text file
+* Each line holds a source and a target airport ID separated by a comma or whitespace;
+* lines that do not start with two numbers (such as a header) are skipped
+*
+* @param filename The file to read
+* @param queries Filled with the (source, target) pairs in file order
+* @return bool Whether the file could be read
+*/
+bool readQueries(const string& filename, vector<pair<int, int>>& queries);
+
+/**
+* @brief Answers a batch of shortest path queries, running one search per distinct source
+* Queries are grouped by source, and each group is a task for a thread pool. Its search stops once
+* every target of the group is settled. Results are handed to sink one group at a time as
+* groups finish, so they arrive in no particular order (each carries its query position)
+*
+* @param g The graph
+* @param queries The (source, target) pairs
+* @param threads How many threads to use (0 for all hardware threads)
+* @param sink Called with each group's results; calls never overlap
+* @return BatchSummary The totals for the batch
+*/
+BatchSummary routeBatch(const Graph& g, const vector<pair<int, int>>& queries, int threads,
+    const function<void(const vector<RouteResult>&)>& sink);
+
+/**
+* @brief Answers a batch of queries with routeBatch, streaming the results to a file
+* The CSV format has a header and one line per query: query,source,target,distance,hops,path
+* where path is the airport IDs separated by spaces (distance is inf and hops is -1 without a path).
+* The binary format starts with the 8 characters ROUTES01, then for each query holds int32 query,
+* source, target, a double distance, int32 hops and hops + 1 int32 airport IDs (none without a path)
+*
+* @param g The graph
+* @param queries The (source, target) pairs
+* @param filename The file to write
+* @param binary Whether to write the binary format instead of CSV
+* @param threads How many threads to use (0 for all hardware threads)
+* @param summary If given, filled with the totals for the batch
+* @return bool Whether the file was written
+*/
+bool runBatch(const Graph& g, const vector<pair<int, int>>& queries, const string& filename, bool binary = false,
+    int threads = 0, BatchSummary* summary = nullptr);
@@ -1,49 +1,245 @@
 #include "bet_cent.h"
+#include "../SearchWorkspace.h"
+#include "../Parallel.h"
+#include "shortest_paths.h"
 #include <random>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <condition_variable>
 
 using namespace std;
 
-map<int, int> BetweenessCentrality::getAllScores(const Graph& graph, bool showProgress, bool displayResults) {
-    airport_ids_ = graph.getIDs(); 
+namespace {
+    // the number of sources in a block, whose dependencies are summed together before being added to the scores
+    const int BRANDES_BLOCK = 32;
 
-    Dijkstras d;
+    // the number of samples drawn with one random generator when approximating
+    const int SAMPLE_BLOCK = 64;
 
-    int total_paths = 0;
+    /**
+    * @brief One source's step of Brandes' algorithm, keeping its arrays between sources
+    * The distances, previous airports and queues come from the thread's SearchWorkspace
+    */
+    struct BrandesSearch {
+        vector<double> sigma; // the number of shortest paths from the source, by dense index
+        vector<double> delta; // the dependency of the source on each airport
+        vector<int> order; // the airports in the order they were settled
+        vector<int> position; // each settled airport's place in order
+        int source = -1;
 
-    ProgressBar pb;
-    double numerator = 0;
-    double total_size = airport_ids_.size() * airport_ids_.size();
-    for (size_t id1 = 0; id1 < airport_ids_.size(); id1++) {
-        for (size_t id2 = 0; id2 < airport_ids_.size(); id2++) {
-            if (showProgress) {
-                pb.setProgress(numerator / total_size);
-                cout << pb;
+        /**
+        * @brief Finds the shortest distances and the numbers of shortest paths from a source
+        *
+        * @param csr The snapshot to search
+        * @param s The source's dense index
+        * @param target The dense index to stop at once it is settled (-1 to settle everything reachable)
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        */
+        void search(const CSRGraph& csr, int s, int target, bool weighted) {
+            int n = csr.size();
+            SearchWorkspace& ws = SearchWorkspace::local();
+            ws.reset(n);
+            if (sigma.size() != (size_t)n) {
+                sigma.resize(n);
+                delta.resize(n);
+                position.resize(n);
             }
-            if (airport_ids_[id1] != airport_ids_[id2]) {
-                total_paths++;
-                vector<int> shortest_path = d.getPath(graph, airport_ids_[id1], airport_ids_[id2]);
-                if (shortest_path.size() > 2) {
-                    for (size_t i = 1; i < shortest_path.size() - 1; i++) {
-                        int current_airport = shortest_path[i];
-                        if (airport_scores_.find(current_airport) != airport_scores_.end())
-                            airport_scores_[current_airport]++;
-                        else
-                            airport_scores_[current_airport] = 1;
+            order.clear();
+            source = s;
+            auto settle = [&](int v) {
+                ws.visit(v);
+                position[v] = order.size();
+                order.push_back(v);
+                delta[v] = 0;
+            };
+            ws.reach(s, 0, -1);
+            sigma[s] = 1;
+
+            if (weighted) {
+                // the same queue operations as Dijkstras::getPath, so the previous airports match its paths
+                vector<pair<double, int>>& qu = ws.heap();
+                qu.push_back(make_pair(0.0, s));
+                while (!qu.empty()) {
+                    pair<double, int> node = qu.front();
+                    pop_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+                    qu.pop_back();
+                    int v = node.second;
+                    if (ws.visited(v)) {
+                        continue;
+                    }
+                    settle(v);
+                    if (v == target) {
+                        return;
+                    }
+                    for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+                        int adj = csr.target(e);
+                        double alt = node.first + csr.weight(e);
+                        if (alt < ws.distance(adj)) {
+                            ws.reach(adj, alt, v);
+                            sigma[adj] = sigma[v];
+                            qu.push_back(make_pair(alt, adj));
+                            push_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+                        } else if (alt == ws.distance(adj) && !ws.visited(adj)) {
+                            sigma[adj] += sigma[v];
+                        }
                     }
                 }
             } else {
-                if (airport_scores_.find(airport_ids_[id1]) == airport_scores_.end())
-                    airport_scores_[airport_ids_[id1]] = 0;
-                if (airport_scores_.find(airport_ids_[id2]) == airport_scores_.end())
-                    airport_scores_[airport_ids_[id2]] = 0;
+                vector<int>& queued = ws.queue();
+                queued.push_back(s);
+                for (size_t front = 0; front < queued.size(); front++) {
+                    int v = queued[front];
+                    settle(v);
+                    if (v == target) {
+                        return;
+                    }
+                    double alt = ws.distance(v) + 1;
+                    for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+                        int adj = csr.target(e);
+                        if (!ws.reached(adj)) {
+                            ws.reach(adj, alt, v);
+                            sigma[adj] = sigma[v];
+                            queued.push_back(adj);
+                        } else if (alt == ws.distance(adj)) {
+                            sigma[adj] += sigma[v];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+        * @brief Determines if an incoming connection is the last leg of shortest paths in the last search
+        *
+        * @param csr The snapshot searched
+        * @param w The settled airport the connection leads to
+        * @param j The incoming connection's number (from csr.inBegin(w) to csr.inEnd(w))
+        * @param weighted As in the search
+        * @return bool Whether the connection's origin precedes w on shortest paths
+        */
+        bool precedes(const CSRGraph& csr, int w, int j, bool weighted) const {
+            const SearchWorkspace& ws = SearchWorkspace::local();
+            int v = csr.source(j);
+            if (!ws.visited(v) || position[v] >= position[w]) {
+                return false;
+            }
+            return ws.distance(v) + (weighted ? csr.weight(csr.inEdge(j)) : 1) == ws.distance(w);
+        }
+
+        /**
+        * @brief Searches from a source and finds its dependency on every airport it reaches
+        * Afterwards delta holds the dependencies of the airports in order, except the source's own
+        *
+        * @param csr The snapshot to search
+        * @param s The source's dense index
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        * @param singlePath Whether each target credits only the path through its previous airports
+        */
+        void dependencies(const CSRGraph& csr, int s, bool weighted, bool singlePath) {
+            search(csr, s, -1, weighted);
+            SearchWorkspace& ws = SearchWorkspace::local();
+            // farthest first, each airport passes its dependency back along the last leg of its shortest paths
+            for (size_t i = order.size() - 1; i > 0; i--) {
+                int w = order[i];
+                if (singlePath) {
+                    delta[ws.parent(w)] += 1 + delta[w];
+                } else {
+                    for (int j = csr.inBegin(w); j < csr.inEnd(w); j++) {
+                        if (precedes(csr, w, j, weighted)) {
+                            int v = csr.source(j);
+                            delta[v] += sigma[v] / sigma[w] * (1 + delta[w]);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+        * @brief Searches from a source and adds its dependencies to the scores
+        *
+        * @param csr The snapshot to search
+        * @param s The source's dense index
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        * @param singlePath Whether each target credits only the path through its previous airports
+        * @param scores The scores to add to, by dense index
+        */
+        void run(const CSRGraph& csr, int s, bool weighted, bool singlePath, vector<double>& scores) {
+            dependencies(csr, s, weighted, singlePath);
+            for (size_t i = order.size() - 1; i > 0; i--) {
+                scores[order[i]] += delta[order[i]];
+            }
+        }
+
+        /**
+        * @brief Picks one of the last search's shortest paths to a target uniformly at random
+        * Walks back from the target, choosing each previous airport with probability proportional to its paths
+        *
+        * @param csr The snapshot searched
+        * @param target The target's dense index (must have been settled)
+        * @param weighted As in the search
+        * @param generator The random generator
+        * @param interior Filled with the airports strictly inside the path, from the target back
+        */
+        void samplePath(const CSRGraph& csr, int target, bool weighted, mt19937_64& generator, vector<int>& interior) {
+            interior.clear();
+            for (int w = target; w != source; ) {
+                double pick = uniform_real_distribution<double>(0, sigma[w])(generator);
+                int chosen = -1;
+                for (int j = csr.inBegin(w); j < csr.inEnd(w) && pick >= 0; j++) {
+                    if (precedes(csr, w, j, weighted)) {
+                        chosen = csr.source(j);
+                        pick -= sigma[chosen];
+                    }
+                }
+                w = chosen;
+                if (w != source) {
+                    interior.push_back(w);
+                }
+            }
+        }
+    };
+
+    /**
+    * @brief Finds every airport's shortest distance to a target, following connections backwards
+    *
+    * @param csr The snapshot to search
+    * @param target The target's dense index
+    * @param weighted Whether distances are the least distance (true) or the fewest legs (false)
+    * @param distances Filled with each airport's distance to the target (infinity if it has no path)
+    */
+    void distancesTo(const CSRGraph& csr, int target, bool weighted, vector<double>& distances) {
+        if (weighted) {
+            shortestDistances(csr, target, true, distances);
+            return;
+        }
+        distances.assign(csr.size(), numeric_limits<double>::infinity());
+        distances[target] = 0;
+        vector<int> queued(1, target);
+        for (size_t front = 0; front < queued.size(); front++) {
+            int w = queued[front];
+            for (int j = csr.inBegin(w); j < csr.inEnd(w); j++) {
+                int v = csr.source(j);
+                if (distances[v] == numeric_limits<double>::infinity()) {
+                    distances[v] = distances[w] + 1;
+                    queued.push_back(v);
+                }
             }
-            numerator++;
         }
     }
+}
 
-    if (showProgress) {
-        pb.setProgress(1);
-        cout << pb << endl;
+map<int, int> BetweenessCentrality::getAllScores(const Graph& graph, bool showProgress, bool displayResults) {
+    airport_ids_ = graph.getIDs(); 
+
+    // one tree per source gives the paths Dijkstras::getPath would find to every target at once
+    const CSRGraph& csr = graph.csr();
+    vector<double> scores = _brandes(csr, true, true, showProgress, 0);
+
+    long long total_paths = 0;
+    for (int v = 0; v < csr.size(); v++) {
+        total_paths += csr.size() - 1;
+        airport_scores_[csr.getID(v)] += (int)llround(scores[v]);
     }
 
     if (displayResults) {
@@ -74,6 +270,8 @@ map<int, int> BetweenessCentrality::getProbabilisticScores(const Graph& graph, i
     uniform_int_distribution<int> distribution(0, graph.size() - 1);
 
     ProgressBar pb;
+    Dijkstras d;
+    vector<int> shortest_path;
 
     while (sampled < sampleSize) {
         if (showProgress) {
@@ -87,8 +285,7 @@ map<int, int> BetweenessCentrality::getProbabilisticScores(const Graph& graph, i
         while (id1 == id2 || airport_scores_.find(id2) != airport_scores_.end())
             id2 = airport_ids_[distribution(generator)];
 
-        Dijkstras d;
-        vector<int> shortest_path = d.getPath(graph, id1, id2);
+        d.getPath(graph, id1, id2, shortest_path);
         if (shortest_path.size() == 0/* && skipNonPaths == false*/) {
             if (airport_scores_.find(id1) == airport_scores_.end()) airport_scores_[id1] = 0;
             if (airport_scores_.find(id2) == airport_scores_.end()) airport_scores_[id2] = 0;
@@ -128,6 +325,368 @@ map<int, int> BetweenessCentrality::getProbabilisticScores(const Graph& graph, i
     return airport_scores_;
 }
 
+map<int, double> BetweenessCentrality::getBrandesScores(const Graph& graph, bool weighted, bool singlePath,
+    bool showProgress, int threads) {
+    const CSRGraph& csr = graph.csr();
+    airport_ids_ = csr.getIDs();
+    vector<double> scores = _brandes(csr, weighted, singlePath, showProgress, threads);
+
+    map<int, double> result;
+    airport_scores_.clear();
+    for (int v = 0; v < csr.size(); v++) {
+        result[csr.getID(v)] = scores[v];
+        airport_scores_[csr.getID(v)] = (int)llround(scores[v]);
+    }
+    return result;
+}
+
+vector<double> BetweenessCentrality::_brandes(const CSRGraph& csr, bool weighted, bool singlePath, bool showProgress,
+    int threads) {
+    int n = csr.size();
+    vector<double> scores(n, 0);
+    if (threads <= 0) {
+        threads = defaultThreads();
+    }
+    int blocks = (n + BRANDES_BLOCK - 1) / BRANDES_BLOCK;
+    threads = max(1, min(threads, blocks));
+    // threads take blocks one after another from a window of several blocks per thread, each block summing into its
+    // own array; a block's array is added to the scores once every earlier block has been, so no sum depends on
+    // which thread ran which block, and a slow block only holds up the others once the window is used up
+    const int WINDOW = 4;
+    int window = min(blocks, threads * WINDOW);
+    vector<BrandesSearch> searches(threads);
+    vector<vector<double>> partial(window, vector<double>(n, 0.0));
+    vector<bool> finished(blocks, false);
+    int added = 0; // every block before this one has been added to the scores
+    atomic<int> next(0);
+    mutex lock;
+    condition_variable freed;
+    ProgressBar pb;
+    runTeam(threads, [&](int t) {
+        for (int block = next++; block < blocks; block = next++) {
+            // the block's array is still in use until the block a window earlier has been added
+            {
+                unique_lock<mutex> guard(lock);
+                freed.wait(guard, [&] { return block < added + window; });
+            }
+            vector<double>& own = partial[block % window];
+            int first = block * BRANDES_BLOCK;
+            for (int s = first; s < min(n, first + BRANDES_BLOCK); s++) {
+                searches[t].run(csr, s, weighted, singlePath, own);
+            }
+
+            unique_lock<mutex> guard(lock);
+            finished[block] = true;
+            for (; added < blocks && finished[added]; added++) {
+                vector<double>& sums = partial[added % window];
+                for (int v = 0; v < n; v++) {
+                    scores[v] += sums[v];
+                    sums[v] = 0;
+                }
+            }
+            if (showProgress) {
+                pb.setProgress((double) added / blocks);
+                cout << pb;
+            }
+            freed.notify_all();
+        }
+    });
+    if (showProgress) {
+        pb.setProgress(1);
+        cout << pb << endl;
+    }
+    return scores;
+}
+
+map<int, double> BetweenessCentrality::getApproximateScores(const Graph& graph, double epsilon, double delta,
+    bool weighted, unsigned seed, int threads) {
+    map<int, double> result;
+    samples_taken_ = 0;
+    if (!(epsilon > 0 && epsilon < 1 && delta > 0 && delta < 1)) {
+        return result;
+    }
+    const CSRGraph& csr = graph.csr();
+    int n = csr.size();
+    airport_ids_ = csr.getIDs();
+    if (threads <= 0) {
+        threads = defaultThreads();
+    }
+
+    // no shortest path holds more airports than its weakly connected component
+    vector<int> componentSizes(csr.weakComponents(), 0);
+    for (int v = 0; v < n; v++) {
+        componentSizes[csr.weakComponent(v)]++;
+    }
+    int diameter = componentSizes.empty() ? 0 : *max_element(componentSizes.begin(), componentSizes.end());
+    // Riondato and Kornaropoulos' sample size, in whole blocks
+    double needed = 0.5 / (epsilon * epsilon) * (floor(log2(max(diameter - 2, 1))) + 1 + log(2 / delta));
+    long long cap = ((long long)ceil(needed) + SAMPLE_BLOCK - 1) / SAMPLE_BLOCK * SAMPLE_BLOCK;
+    vector<long long> checkpoints;
+    for (long long m = cap; m > 16 * SAMPLE_BLOCK; m = (m / 2 + SAMPLE_BLOCK - 1) / SAMPLE_BLOCK * SAMPLE_BLOCK) {
+        checkpoints.push_back(m);
+    }
+    if (checkpoints.empty() || checkpoints.back() != min(cap, 16LL * SAMPLE_BLOCK)) {
+        checkpoints.push_back(min(cap, 16LL * SAMPLE_BLOCK));
+    }
+    reverse(checkpoints.begin(), checkpoints.end());
+    // every airport at every checkpoint but the cap shares the other half of delta
+    double logTerm = log(4.0 * max(n, 1) * max<size_t>(checkpoints.size() - 1, 1) / delta);
+
+    vector<BrandesSearch> searches(threads);
+    vector<vector<long long>> counts(threads, vector<long long>(n, 0));
+    vector<vector<int>> interiors(threads);
+    vector<long long> total(n, 0);
+    for (size_t k = 0; k < checkpoints.size() && n >= 3; k++) {
+        int firstBlock = samples_taken_ / SAMPLE_BLOCK;
+        int blocks = (checkpoints[k] - samples_taken_) / SAMPLE_BLOCK;
+        parallelFor(blocks, threads, [&](int i, int thread) {
+            seed_seq sequence{seed, (unsigned)(firstBlock + i)};
+            mt19937_64 generator(sequence);
+            uniform_int_distribution<int> pickSource(0, n - 1), pickTarget(0, n - 2);
+            for (int sample = 0; sample < SAMPLE_BLOCK; sample++) {
+                int s = pickSource(generator);
+                int t = pickTarget(generator);
+                if (t >= s) {
+                    t++;
+                }
+                if (!csr.mayReach(s, t)) {
+                    continue;
+                }
+                searches[thread].search(csr, s, t, weighted);
+                if (!SearchWorkspace::local().visited(t)) {
+                    continue;
+                }
+                searches[thread].samplePath(csr, t, weighted, generator, interiors[thread]);
+                for (int w : interiors[thread]) {
+                    counts[thread][w]++;
+                }
+            }
+        });
+        samples_taken_ = checkpoints[k];
+        fill(total.begin(), total.end(), 0);
+        for (int thread = 0; thread < threads; thread++) {
+            for (int v = 0; v < n; v++) {
+                total[v] += counts[thread][v];
+            }
+        }
+
+        // the empirical Bernstein bound on every airport's share, from the variance of its points so far
+        double m = samples_taken_;
+        double worst = 0;
+        for (int v = 0; v < n; v++) {
+            double share = total[v] / m;
+            double variance = share * (1 - share) * m / (m - 1);
+            worst = max(worst, sqrt(2 * variance * logTerm / m) + 7 * logTerm / (3 * (m - 1)));
+        }
+        if (worst <= epsilon) {
+            break;
+        }
+    }
+
+    airport_scores_.clear();
+    double pairs = (double)n * (n - 1);
+    for (int v = 0; v < n; v++) {
+        double score = samples_taken_ > 0 ? total[v] * pairs / samples_taken_ : 0;
+        result[csr.getID(v)] = score;
+        airport_scores_[csr.getID(v)] = (int)llround(score);
+    }
+    return result;
+}
+
+// A spoke (an airport whose only routes are out to and back from one hub) depends, as a source, on what its hub
+// does, so the hubs with spokes are searched first and cover their spokes exactly. The other sources are searched
+// in a random order, as a sample without replacement, and at a growing series of checkpoints every airport still in
+// the running gets bounds: no lower than its exact sum so far, no higher than that plus its largest possible
+// dependency on each unsearched source of its weakly connected component. Airports whose upper bound falls below
+// the k-th highest lower bound are pruned for good, and the search stops once no airport could beat one ranked above
+// it by more than epsilon. Only those bounds prune and certify; the normal confidence interval of
+// ProgressiveBetweenness (with delta split over every airport and checkpoint) may stop the search sooner when
+// epsilon is above 0, and the ranking is then only probable.
+vector<CentralityEstimate> BetweenessCentrality::getTopScores(const Graph& graph, int k, double epsilon, double delta,
+    bool weighted, unsigned seed, int threads) {
+    vector<CentralityEstimate> top;
+    sources_searched_ = 0;
+    ranking_certified_ = false;
+    const CSRGraph& csr = graph.csr();
+    int n = csr.size();
+    if (k <= 0 || n == 0 || !(epsilon >= 0 && epsilon < 1 && delta > 0 && delta < 1)) {
+        return top;
+    }
+    k = min(k, n);
+    airport_ids_ = csr.getIDs();
+    if (threads <= 0) {
+        threads = defaultThreads();
+    }
+
+    // an airport whose only route out and only route in are with the same hub (a spoke) depends, as a source, on
+    // everything its hub does, and on the hub itself for every other airport the hub reaches
+    vector<int> spokes(n, 0);
+    vector<bool> spoke(n, false);
+    for (int v = 0; v < n; v++) {
+        if (csr.outDegree(v) == 1 && csr.inDegree(v) == 1) {
+            int hub = csr.target(csr.outBegin(v));
+            if (hub != v && csr.source(csr.inBegin(v)) == hub) {
+                spoke[v] = true;
+                spokes[hub]++;
+            }
+        }
+    }
+    // hubs with spokes are always searched, covering their spokes exactly; the other airports with routes out are
+    // sampled, in a random order so the first ones searched are a sample without replacement
+    vector<int> hubs, order;
+    for (int s = 0; s < n; s++) {
+        if (!spoke[s] && csr.outDegree(s) > 0) {
+            (spokes[s] > 0 ? hubs : order).push_back(s);
+        }
+    }
+    int sources = order.size();
+    mt19937 generator(seed);
+    shuffle(order.begin(), order.end(), generator);
+
+    // a source's dependency on an airport is at most the rest of the airport's weakly connected component, and
+    // none at all if no route enters or leaves the airport
+    vector<int> componentSizes(csr.weakComponents(), 0), unsearched(csr.weakComponents(), 0);
+    for (int v = 0; v < n; v++) {
+        componentSizes[csr.weakComponent(v)]++;
+    }
+    for (int s : order) {
+        unsearched[csr.weakComponent(s)]++;
+    }
+    vector<double> range(n);
+    for (int v = 0; v < n; v++) {
+        bool passable = csr.inDegree(v) > 0 && csr.outDegree(v) > 0;
+        range[v] = passable ? componentSizes[csr.weakComponent(v)] - 2 : 0;
+    }
+
+    // checkpoints grow by half each time, in whole blocks, up to every sampled source
+    vector<int> checkpoints(1, min(sources, 4 * BRANDES_BLOCK));
+    while (checkpoints.back() < sources) {
+        int next = (checkpoints.back() * 3 / 2 + BRANDES_BLOCK - 1) / BRANDES_BLOCK * BRANDES_BLOCK;
+        checkpoints.push_back(min(sources, next));
+    }
+    // every airport at every checkpoint but the last (which is exact) shares delta, on both sides of its estimate;
+    // the normal quantile leaving that much in the tails is found by bisection
+    double tail = delta / (2.0 * n * max<size_t>(checkpoints.size() - 1, 1));
+    double lowZ = 0, highZ = 40;
+    for (int i = 0; i < 100; i++) {
+        double z = (lowZ + highZ) / 2;
+        (0.5 * erfc(z / sqrt(2.0)) > tail ? lowZ : highZ) = z;
+    }
+    double z = highZ;
+    double tolerance = epsilon * n * (n - 1.0);
+
+    int blocks = (max(sources, (int)hubs.size()) + BRANDES_BLOCK - 1) / BRANDES_BLOCK;
+    threads = max(1, min(threads, blocks));
+    vector<BrandesSearch> searches(threads);
+    vector<vector<double>> partialSums(threads, vector<double>(n)), partialSquares(threads, vector<double>(n));
+    // searches from sources[from] to sources[to - 1] a round of one block per thread at a time, adding each source's
+    // dependencies and those of its spokes to the totals in block order as in _brandes
+    auto searchBlocks = [&](const vector<int>& list, int from, int to, vector<double>& totals,
+        vector<double>* squareTotals) {
+        while (from < to) {
+            int count = min(threads, (to - from + BRANDES_BLOCK - 1) / BRANDES_BLOCK);
+            parallelFor(count, threads, [&](int i, int) {
+                fill(partialSums[i].begin(), partialSums[i].end(), 0.0);
+                fill(partialSquares[i].begin(), partialSquares[i].end(), 0.0);
+                int first = from + i * BRANDES_BLOCK;
+                for (int j = first; j < min(to, first + BRANDES_BLOCK); j++) {
+                    BrandesSearch& search = searches[i];
+                    int s = list[j];
+                    search.dependencies(csr, s, weighted, false);
+                    for (size_t p = 1; p < search.order.size(); p++) {
+                        double dependency = (1 + spokes[s]) * search.delta[search.order[p]];
+                        partialSums[i][search.order[p]] += dependency;
+                        partialSquares[i][search.order[p]] += dependency * dependency;
+                    }
+                    partialSums[i][s] += spokes[s] * (search.order.size() - 2.0);
+                }
+            });
+            for (int i = 0; i < count; i++) {
+                for (int v = 0; v < n; v++) {
+                    totals[v] += partialSums[i][v];
+                    if (squareTotals) {
+                        (*squareTotals)[v] += partialSquares[i][v];
+                    }
+                }
+            }
+            from = min(to, from + count * BRANDES_BLOCK);
+        }
+    };
+
+    vector<double> exact(n, 0), sums(n, 0), squares(n, 0), estimate(n), low(n), high(n), likelyLow(n), likelyHigh(n);
+    searchBlocks(hubs, 0, hubs.size(), exact, nullptr);
+    vector<int> candidates(n);
+    for (int v = 0; v < n; v++) {
+        candidates[v] = v;
+    }
+    // whether no airport could beat one ranked above it by more than the tolerance, given those bounds
+    auto apart = [&](const vector<double>& lows, const vector<double>& highs) {
+        double lowest = numeric_limits<double>::infinity();
+        for (size_t i = 0; i < candidates.size(); i++) {
+            int v = candidates[i];
+            if (highs[v] - lowest > tolerance) {
+                return false;
+            }
+            if ((int)i < k) {
+                lowest = min(lowest, lows[v]);
+            }
+        }
+        return true;
+    };
+    int done = 0;
+    for (int checkpoint : checkpoints) {
+        searchBlocks(order, done, checkpoint, sums, &squares);
+        for (; done < checkpoint; done++) {
+            unsearched[csr.weakComponent(order[done])]--;
+        }
+
+        for (int v : candidates) {
+            // the sources searched count exactly, and the rest can add at most the range each
+            low[v] = exact[v] + sums[v];
+            high[v] = low[v] + unsearched[csr.weakComponent(v)] * range[v];
+            if (done == sources) {
+                estimate[v] = likelyLow[v] = likelyHigh[v] = low[v];
+                continue;
+            }
+            // the same interval as ProgressiveBetweenness' snapshots, for the sampled sources
+            double mean = sums[v] / done;
+            double variance = max(0.0, (squares[v] - done * mean * mean) / (done - 1));
+            double margin = z * sources * sqrt(variance / done * (sources - done) / (sources - 1));
+            estimate[v] = min(high[v], max(low[v], exact[v] + sources * mean));
+            likelyLow[v] = max(low[v], estimate[v] - margin);
+            likelyHigh[v] = min(high[v], estimate[v] + margin);
+        }
+
+        // airports that cannot reach the k-th highest lower bound are out of the running for good
+        vector<double> lows;
+        for (int v : candidates) {
+            lows.push_back(low[v]);
+        }
+        nth_element(lows.begin(), lows.begin() + k - 1, lows.end(), greater<double>());
+        double cutoff = lows[k - 1];
+        candidates.erase(remove_if(candidates.begin(), candidates.end(), [&](int v) {
+            return high[v] < cutoff;
+        }), candidates.end());
+        sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+            return estimate[a] > estimate[b] || (estimate[a] == estimate[b] && a < b);
+        });
+
+        ranking_certified_ = apart(low, high);
+        if (ranking_certified_ || (epsilon > 0 && apart(likelyLow, likelyHigh))) {
+            break;
+        }
+    }
+
+    sources_searched_ = hubs.size() + done;
+    airport_scores_.clear();
+    for (int i = 0; i < k; i++) {
+        int v = candidates[i];
+        top.push_back(CentralityEstimate{csr.getID(v), estimate[v], max(high[v] - estimate[v], estimate[v] - low[v])});
+        airport_scores_[csr.getID(v)] = (int)llround(estimate[v]);
+    }
+    return top;
+}
+
 set<int> BetweenessCentrality::getAirportsWithMinFrequency(int frequency) {
     set<int> score_vector;
     for (auto i : airport_scores_) {
@@ -137,3 +696,264 @@ set<int> BetweenessCentrality::getAirportsWithMinFrequency(int frequency) {
     }
     return score_vector;
 }
+
+ProgressiveBetweenness::ProgressiveBetweenness(const Graph& graph, bool weighted, unsigned seed, double z)
+    : csr_(graph.csr()), weighted_(weighted), z_(z), next_(0), stopping_(false), done_(0), published_(0) {
+    int n = csr_.size();
+    order_.resize(n);
+    for (int v = 0; v < n; v++) {
+        order_[v] = v;
+    }
+    mt19937 generator(seed);
+    shuffle(order_.begin(), order_.end(), generator);
+    sums_.assign(n, 0);
+    squares_.assign(n, 0);
+    shared_ptr<CentralitySnapshot> empty = make_shared<CentralitySnapshot>();
+    empty->totalSources = n;
+    snapshot_ = empty;
+}
+
+ProgressiveBetweenness::~ProgressiveBetweenness() {
+    stop();
+}
+
+void ProgressiveBetweenness::start(int threads, int publishEvery) {
+    if (!workers_.empty() || finished()) {
+        return;
+    }
+    if (threads <= 0) {
+        threads = defaultThreads();
+    }
+    if (publishEvery <= 0) {
+        publishEvery = max(BRANDES_BLOCK, (int)order_.size() / 50);
+    }
+    stopping_ = false;
+    for (int t = 0; t < threads; t++) {
+        workers_.push_back(thread(&ProgressiveBetweenness::_work, this, publishEvery));
+    }
+}
+
+void ProgressiveBetweenness::stop() {
+    stopping_ = true;
+    wait();
+    _publish();
+}
+
+void ProgressiveBetweenness::wait() {
+    for (thread& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+vector<CentralityEstimate> ProgressiveBetweenness::topK(int k) const {
+    shared_ptr<const CentralitySnapshot> latest = snapshot();
+    k = max(0, min(k, (int)latest->ranking.size()));
+    return vector<CentralityEstimate>(latest->ranking.begin(), latest->ranking.begin() + k);
+}
+
+void ProgressiveBetweenness::_work(int publishEvery) {
+    int n = order_.size();
+    BrandesSearch search;
+    vector<double> sums(n), squares(n);
+    // blocks are only taken while running, and always finished, so a stopped job resumes where it left off
+    while (!stopping_) {
+        int begin = next_.fetch_add(BRANDES_BLOCK);
+        if (begin >= n) {
+            break;
+        }
+        int end = min(n, begin + BRANDES_BLOCK);
+        fill(sums.begin(), sums.end(), 0.0);
+        fill(squares.begin(), squares.end(), 0.0);
+        for (int i = begin; i < end; i++) {
+            search.dependencies(csr_, order_[i], weighted_, false);
+            for (size_t j = 1; j < search.order.size(); j++) {
+                double dependency = search.delta[search.order[j]];
+                sums[search.order[j]] += dependency;
+                squares[search.order[j]] += dependency * dependency;
+            }
+        }
+
+        bool publish = false;
+        {
+            lock_guard<mutex> lock(mutex_);
+            for (int v = 0; v < n; v++) {
+                sums_[v] += sums[v];
+                squares_[v] += squares[v];
+            }
+            done_ += end - begin;
+            if (done_ - published_ >= publishEvery || done_ == n) {
+                published_ = done_;
+                publish = true;
+            }
+        }
+        if (publish) {
+            _publish();
+        }
+    }
+}
+
+void ProgressiveBetweenness::_publish() {
+    // one snapshot is made at a time, so a later one never gets replaced by an earlier one
+    lock_guard<mutex> publishing(publishing_);
+    vector<double> sums, squares;
+    int k;
+    {
+        lock_guard<mutex> lock(mutex_);
+        sums = sums_;
+        squares = squares_;
+        k = done_;
+    }
+    int n = order_.size();
+    if (k == snapshot()->sources && k > 0) {
+        return;
+    }
+
+    shared_ptr<CentralitySnapshot> latest = make_shared<CentralitySnapshot>();
+    latest->sources = k;
+    latest->totalSources = n;
+    double inf = numeric_limits<double>::infinity();
+    for (int v = 0; v < n; v++) {
+        CentralityEstimate estimate{csr_.getID(v), 0, inf};
+        if (k == n) {
+            estimate.score = sums[v];
+            estimate.margin = 0;
+        } else if (k > 0) {
+            double mean = sums[v] / k;
+            estimate.score = n * mean;
+            // the sample variance of the dependencies, with the correction for sampling without replacement
+            if (k > 1) {
+                double variance = max(0.0, (squares[v] - k * mean * mean) / (k - 1));
+                estimate.margin = z_ * n * sqrt(variance / k * (n - k) / (n - 1));
+            }
+        }
+        latest->ranking.push_back(estimate);
+    }
+    sort(latest->ranking.begin(), latest->ranking.end(), [](const CentralityEstimate& a, const CentralityEstimate& b) {
+        return a.score > b.score || (a.score == b.score && a.id < b.id);
+    });
+    atomic_store(&snapshot_, shared_ptr<const CentralitySnapshot>(latest));
+}
+
+void DynamicBetweenness::build(const Graph& graph, int threads) {
+    const CSRGraph& csr = graph.csr();
+    int n = csr.size();
+    fingerprint_ = csr.fingerprint();
+    ids_ = csr.getIDs();
+    scores_.assign(n, 0);
+    dependencies_.assign(n, vector<Dependency>());
+    vector<int> sources(n);
+    for (int s = 0; s < n; s++) {
+        sources[s] = s;
+    }
+    _recompute(csr, sources, threads);
+}
+
+bool DynamicBetweenness::connect(Graph& graph, int id1, int id2, int threads) {
+    return _update(graph, id1, id2, true, threads);
+}
+
+bool DynamicBetweenness::disconnect(Graph& graph, int id1, int id2, int threads) {
+    return _update(graph, id1, id2, false, threads);
+}
+
+bool DynamicBetweenness::_update(Graph& graph, int id1, int id2, bool adding, int threads) {
+    sources_updated_ = 0;
+    if (!graph.inGraph(id1) || !graph.inGraph(id2) || id1 == id2 || graph.connectedTo(id1, id2) == adding) {
+        return false;
+    }
+    const CSRGraph& before = graph.csr();
+    if (!matches(before)) {
+        return false;
+    }
+    int u = before.getIndex(id1), v = before.getIndex(id2);
+    double length = 1;
+    if (weighted_) {
+        // the same distance Graph::connect gives a new route
+        length = adding ? before.straightDistance(u, v) : before.weight(before.findEdge(u, v));
+    }
+
+    // the sources whose shortest paths use the route before it is cut, or after it is added: those whose distance
+    // to its origin plus its length is at most their distance to its destination. Adding it cannot shorten the way
+    // to its origin, so the test holds after adding exactly when it holds now
+    vector<double> toOrigin, toDestination;
+    distancesTo(before, u, weighted_, toOrigin);
+    distancesTo(before, v, weighted_, toDestination);
+    vector<int> affected;
+    for (int s = 0; s < before.size(); s++) {
+        // distances summed from the other end can differ in the last bits, so near-ties count as ties
+        if (toOrigin[s] != numeric_limits<double>::infinity()
+            && toOrigin[s] + length <= toDestination[s] + 1e-9 * toDestination[s]) {
+            affected.push_back(s);
+        }
+    }
+
+    if (adding) {
+        graph.connect(id1, id2);
+    } else {
+        graph.disconnect(id1, id2);
+    }
+    const CSRGraph& after = graph.csr();
+    fingerprint_ = after.fingerprint();
+    _recompute(after, affected, threads);
+    return true;
+}
+
+void DynamicBetweenness::_recompute(const CSRGraph& csr, const vector<int>& sources, int threads) {
+    sources_updated_ = sources.size();
+    if (sources.empty()) {
+        return;
+    }
+    if (threads <= 0) {
+        threads = defaultThreads();
+    }
+    threads = max(1, min(threads, (int)sources.size()));
+    vector<BrandesSearch> searches(threads);
+    vector<vector<Dependency>> fresh(sources.size());
+    parallelFor(sources.size(), threads, [&](int i, int thread) {
+        BrandesSearch& search = searches[thread];
+        search.dependencies(csr, sources[i], weighted_, false);
+        for (size_t j = 1; j < search.order.size(); j++) {
+            if (search.delta[search.order[j]] != 0) {
+                fresh[i].push_back(Dependency{search.order[j], search.delta[search.order[j]]});
+            }
+        }
+        fresh[i].shrink_to_fit();
+    });
+    // patched in source order, so the scores do not depend on the number of threads
+    for (size_t i = 0; i < sources.size(); i++) {
+        vector<Dependency>& kept = dependencies_[sources[i]];
+        for (const Dependency& dependency : kept) {
+            scores_[dependency.airport] -= dependency.delta;
+        }
+        for (const Dependency& dependency : fresh[i]) {
+            scores_[dependency.airport] += dependency.delta;
+        }
+        kept.swap(fresh[i]);
+    }
+}
+
+map<int, double> DynamicBetweenness::getScores() const {
+    map<int, double> result;
+    for (size_t v = 0; v < ids_.size(); v++) {
+        result[ids_[v]] = scores_[v];
+    }
+    return result;
+}
+
+double DynamicBetweenness::getScore(int id) const {
+    auto it = lower_bound(ids_.begin(), ids_.end(), id);
+    if (it == ids_.end() || *it != id) {
+        return 0;
+    }
+    return scores_[it - ids_.begin()];
+}
+
+size_t DynamicBetweenness::bytes() const {
+    size_t total = ids_.capacity() * sizeof(int) + scores_.capacity() * sizeof(double)
+        + dependencies_.capacity() * sizeof(vector<Dependency>);
+    for (const vector<Dependency>& kept : dependencies_) {
+        total += kept.capacity() * sizeof(Dependency);
+    }
+    return total;
+}
@@ -3,6 +3,7 @@
 #include "Graph.h"
 #include "readdat.h"
 #include "dijkstra.h"
+#include "../CSRGraph.h"
 #include "../ProgressBar.h"
 
 #include <vector>
@@ -14,9 +15,33 @@
 #include <queue>
 #include <stack>
 #include <set>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
 
 using namespace std;
 
+/**
+ * @brief An airport's estimated betweenness score in a progressive or top-k computation
+ */
+struct CentralityEstimate {
+    int id;
+    double score; // the estimate, on BetweenessCentrality::getBrandesScores' scale
+    double margin; // the half-width of the confidence interval around it (0 once exact, infinity in a progressive
+    // computation before 2 sources)
+};
+
+/**
+ * @brief The estimates a progressive computation published at one moment
+ */
+struct CentralitySnapshot {
+    int sources = 0; // the sources processed so far
+    int totalSources = 0; // every airport is a source
+    vector<CentralityEstimate> ranking; // every airport, highest estimate first (ties by ID)
+};
+
 class BetweenessCentrality {
     public:
 
@@ -24,7 +49,9 @@ class BetweenessCentrality {
         * @brief Applies Betweeness Centrality, incorporated with Dijkstras Algorithm
         * to calculate scores (frquencies) for each airport
         * Airport scores are determined by the number of appearences on the shortest paths
-        * between all airports
+        * between all airports, counting the one path Dijkstras::getPath finds for each pair.
+        * Runs as getBrandesScores(graph, true, true): one search per source instead of one per pair,
+        * on every hardware thread
         *
         * @param graph The graph on which to apply betweenness centrality
         * @param showProgress Whether to show a progress bar
@@ -42,6 +69,104 @@ class BetweenessCentrality {
         */
         set<int> getAirportsWithMinFrequency(int frequency);
 
+        /**
+        * @brief Computes betweenness centrality with Brandes' algorithm
+        * One search per source finds every airport's shortest distance and number of shortest paths, then the
+        * airports are visited from farthest to nearest, passing each one's dependency (the share of the
+        * source's shortest paths through it) back to its predecessors on those paths. This takes
+        * O(VE + V^2 log V) in total instead of a search for every pair. Pairs with several shortest paths
+        * split their credit evenly among them, so scores can be fractional.
+        *
+        * Sources are split into fixed blocks that threads take one after another as they finish, each block
+        * summing its sources' dependencies in its own array; the arrays are added to the scores in block order.
+        * Every sum is therefore taken in the same order whatever the number of threads, and the scores are
+        * identical to the last bit
+        *
+        * @param graph The graph on which to apply betweenness centrality
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        * @param singlePath Whether each pair credits only the one path Dijkstras::getPath finds (the first
+        * breadth-first path when unweighted), reproducing getAllScores, instead of splitting it
+        * @param showProgress Whether to show a progress bar
+        * @param threads How many threads to search from sources on (0 for all hardware threads)
+        * @return map<int, double> A map of every Airport ID to its betweenness score (also kept, rounded, for
+        * getAirportsWithMinFrequency)
+        */
+        map<int, double> getBrandesScores(const Graph& graph, bool weighted = true, bool singlePath = false,
+            bool showProgress = false, int threads = 0);
+
+        /**
+        * @brief Estimates betweenness centrality by sampling shortest paths, within a guaranteed error
+        * Riondato and Kornaropoulos' sampling: each sample is a uniformly random ordered pair of distinct airports
+        * and one of its shortest paths chosen uniformly at random, and every airport inside the path gains a point.
+        * An airport's share of the samples estimates its share of all pairs' shortest paths, which is its
+        * getBrandesScores score divided by V(V - 1), and with probability at least 1 - delta every estimate is
+        * within epsilon of that share. The samples needed for this are capped using the vertex diameter (at most
+        * the largest weakly connected component), but sampling stops at the first of a doubling series of
+        * checkpoints where an empirical Bernstein bound, much tighter for airports on few paths, already
+        * certifies every airport. Half of delta goes to the cap and half to the checkpoints.
+        *
+        * Samples are drawn in blocks that each seed their own random generator from the seed and the block's
+        * number, so the estimates depend on the seed but not on the number of threads
+        *
+        * @param graph The graph on which to apply betweenness centrality
+        * @param epsilon The largest error allowed in any airport's share of the shortest paths (between 0 and 1)
+        * @param delta The probability allowed of any estimate missing by more (between 0 and 1)
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        * @param seed The random seed
+        * @param threads How many threads to draw samples on (0 for all hardware threads)
+        * @return map<int, double> A map of every Airport ID to its estimated score on getBrandesScores' scale (also
+        * kept, rounded, for getAirportsWithMinFrequency), or an empty map if epsilon or delta is out of range
+        */
+        map<int, double> getApproximateScores(const Graph& graph, double epsilon, double delta, bool weighted = true,
+            unsigned seed = 1, int threads = 0);
+
+        /**
+        * @brief Gets how many paths the last getApproximateScores sampled
+        *
+        * @return long long The number of samples
+        */
+        long long samplesTaken() const { return samples_taken_; }
+
+        /**
+        * @brief Finds the airports with the highest betweenness scores, and their order, without every exact score
+        * Searches from a random sample of sources until every airport's bounds (no lower than its sum so far, no
+        * higher than that plus the most the unsearched sources could add) certify the ranking to within epsilon.
+        * With epsilon above 0 it may stop sooner, when the normal approximation says the ranking is probably within
+        * epsilon (wrong with probability about delta); such a ranking is not certified (see rankingCertified).
+        *
+        * Sources are searched in the same blocks as getBrandesScores, so the result depends on the seed but not on
+        * the number of threads
+        *
+        * @param graph The graph on which to apply betweenness centrality
+        * @param k The number of airports to rank (at most every airport)
+        * @param epsilon The largest difference, as a share of all pairs' shortest paths, of airports that may be out
+        * of order (0 or more, below 1)
+        * @param delta The probability allowed of a probable ranking being wrong by more, under the normal
+        * approximation (between 0 and 1)
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        * @param seed The random seed of the source order
+        * @param threads How many threads to search from sources on (0 for all hardware threads)
+        * @return vector<CentralityEstimate> The top k airports, highest estimate first, with the widest half of
+        * their bounds as margins, which hold even if the ranking is not certified (also kept, rounded, for
+        * getAirportsWithMinFrequency), or an empty vector if k, epsilon or delta is out of range
+        */
+        vector<CentralityEstimate> getTopScores(const Graph& graph, int k, double epsilon, double delta,
+            bool weighted = true, unsigned seed = 1, int threads = 0);
+
+        /**
+        * @brief Gets how many sources the last getTopScores searched from (spokes are covered by their hubs)
+        *
+        * @return int The number of sources
+        */
+        int sourcesSearched() const { return sources_searched_; }
+
+        /**
+        * @brief Determines if the last getTopScores ranking is certified by its bounds, rather than only probable
+        *
+        * @return bool Whether every airport out of order is certainly within epsilon of the one it passed
+        */
+        bool rankingCertified() const { return ranking_certified_; }
+
         /**
         * @brief Applies the betweenness centrality algorithm with a probabilistic approach
         * Instead of considering all pairs of distinct points, uniformly samples a given
@@ -57,9 +182,253 @@ class BetweenessCentrality {
         map<int, int> getProbabilisticScores(const Graph& graph, int sampleSize, bool skipNonPaths = true, bool showProgress = true, bool displayResults = false);
 
     private:
+        /**
+        * @brief Runs Brandes' algorithm from every source
+        *
+        * @param csr The snapshot to search
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        * @param singlePath Whether each pair credits only one shortest path
+        * @param showProgress Whether to show a progress bar
+        * @param threads How many threads to use (0 for all hardware threads)
+        * @return vector<double> The scores, by dense index of the snapshot
+        */
+        vector<double> _brandes(const CSRGraph& csr, bool weighted, bool singlePath, bool showProgress,
+            int threads);
+
         vector<int> airport_ids_; // vector of all airport ids
 
         map<int, int> airport_scores_; // maps airport to Betweenness Centrality Score
 
+        long long samples_taken_ = 0; // the number of samples the last approximation drew
+
+        int sources_searched_ = 0; // the number of sources the last top-k ranking searched from
+
+        bool ranking_certified_ = false; // whether the last top-k ranking was certified by its bounds
+
+};
+
+/**
+ * Class for betweenness centrality that gives a rough ranking quickly and refines it for as long as it runs
+ * Worker threads run Brandes' algorithm from the sources in a random order (Brandes and Pich's source
+ * sampling). After k of the n sources, an airport's score is estimated as n / k times the sum of its
+ * dependencies so far, with a confidence interval from their sample variance, narrowed by the share of
+ * sources already done; once every source is done the scores are exact.
+ *
+ * Estimates are published as snapshots every so many sources. Readers only ever swap in the latest snapshot,
+ * so polling never waits for the workers, and the job can be stopped and started again without losing work
+ */
+class ProgressiveBetweenness {
+    public:
+        /**
+        * @brief Prepares a computation over a copy of a graph's snapshot (later changes to the graph are not seen)
+        *
+        * @param graph The graph on which to apply betweenness centrality
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        * @param seed The random seed of the source order
+        * @param z The normal quantile of the confidence intervals (1.96 for 95%)
+        */
+        ProgressiveBetweenness(const Graph& graph, bool weighted = true, unsigned seed = 1, double z = 1.96);
+
+        /**
+        * @brief Stops the workers
+        */
+        ~ProgressiveBetweenness();
+
+        ProgressiveBetweenness(const ProgressiveBetweenness&) = delete;
+        ProgressiveBetweenness& operator=(const ProgressiveBetweenness&) = delete;
+
+        /**
+        * @brief Starts (or resumes) processing sources in the background
+        * Does nothing if the workers are already running or every source is done
+        *
+        * @param threads How many worker threads to run (0 for all hardware threads)
+        * @param publishEvery How many sources to process between snapshots (0 for about 2% of the airports)
+        */
+        void start(int threads = 0, int publishEvery = 0);
+
+        /**
+        * @brief Stops the workers once their current blocks of sources are done, and publishes a snapshot of them
+        */
+        void stop();
+
+        /**
+        * @brief Blocks until every source is done, or the workers are stopped
+        */
+        void wait();
+
+        /**
+        * @brief Determines if every source is done, so the scores are exact
+        *
+        * @return bool Whether the computation is complete
+        */
+        bool finished() const { return done_ == (int)order_.size(); }
+
+        /**
+        * @brief Gets the latest snapshot, without waiting for the workers
+        *
+        * @return shared_ptr<const CentralitySnapshot> The snapshot (with no sources before the first is published)
+        */
+        shared_ptr<const CentralitySnapshot> snapshot() const { return atomic_load(&snapshot_); }
+
+        /**
+        * @brief Gets the airports with the highest estimates in the latest snapshot, without waiting for the workers
+        *
+        * @param k The number of airports
+        * @return vector<CentralityEstimate> Up to k airports, highest estimate first
+        */
+        vector<CentralityEstimate> topK(int k) const;
+
+    private:
+        /**
+        * @brief Takes blocks of sources until they run out or the workers are stopped
+        *
+        * @param publishEvery How many sources to process between snapshots
+        */
+        void _work(int publishEvery);
+
+        /**
+        * @brief Makes a snapshot of the sums so far and publishes it
+        */
+        void _publish();
+
+        CSRGraph csr_; // the copy of the graph's snapshot
+        bool weighted_;
+        double z_;
+        vector<int> order_; // the sources in the order they are processed
+        atomic<int> next_; // the position in order of the next block to take
+        atomic<bool> stopping_;
+        mutex mutex_; // guards the sums and counters below
+        vector<double> sums_, squares_; // each airport's sum of dependencies and of their squares, by dense index
+        atomic<int> done_; // the sources whose dependencies are in the sums
+        int published_; // done_ at the last snapshot
+        mutex publishing_; // held while making a snapshot
+        vector<thread> workers_;
+        shared_ptr<const CentralitySnapshot> snapshot_; // only read and replaced atomically
 };
 
+/**
+ * Class for exact betweenness centrality that is kept up to date as routes are added and cut
+ * Every source's dependencies (its nonzero shares of the scores, which are only the airports inside its
+ * shortest path DAG) are kept, so a source can be taken back out of the scores without searching again.
+ *
+ * A route from u to v lies on a source's shortest paths, before it is cut or after it is added, only if the
+ * source's distance to u plus the route's length is at most its distance to v. Two backward searches from u
+ * and v find every source's distances to them, and only the sources passing this test are searched again on
+ * the changed graph; their old dependencies are subtracted from the scores and the new ones added. Every other
+ * source's DAG is untouched by the change, so the scores match a full recomputation (to rounding)
+ */
+class DynamicBetweenness {
+    public:
+        /**
+        * @brief Constructs an empty set of scores (nothing can be updated until built)
+        *
+        * @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+        */
+        DynamicBetweenness(bool weighted = true) : weighted_(weighted), fingerprint_(0), sources_updated_(0) {}
+
+        /**
+        * @brief Computes every source's dependencies and the scores from scratch
+        *
+        * @param graph The graph on which to apply betweenness centrality
+        * @param threads How many threads to search from sources on (0 for all hardware threads)
+        */
+        void build(const Graph& graph, int threads = 0);
+
+        /**
+        * @brief Adds a route to the graph and updates the scores
+        *
+        * @param graph The graph the scores were built from (a route is added to it)
+        * @param id1 The ID of the route's origin
+        * @param id2 The ID of the route's destination
+        * @param threads How many threads to search from sources on (0 for all hardware threads)
+        * @return bool Whether the route was added (false, leaving the graph alone, if either airport is not in
+        * the graph, they are the same, the route already exists, or the graph changed since the scores were made)
+        */
+        bool connect(Graph& graph, int id1, int id2, int threads = 0);
+
+        /**
+        * @brief Cuts a route from the graph and updates the scores
+        *
+        * @param graph The graph the scores were built from (the route is removed from it)
+        * @param id1 The ID of the route's origin
+        * @param id2 The ID of the route's destination
+        * @param threads How many threads to search from sources on (0 for all hardware threads)
+        * @return bool Whether the route was cut (false, leaving the graph alone, if there is no such route or
+        * the graph changed since the scores were made)
+        */
+        bool disconnect(Graph& graph, int id1, int id2, int threads = 0);
+
+        /**
+        * @brief Gets every airport's score
+        *
+        * @return map<int, double> A map of every Airport ID to its score, on BetweenessCentrality::getBrandesScores' scale
+        */
+        map<int, double> getScores() const;
+
+        /**
+        * @brief Gets one airport's score
+        *
+        * @param id The airport ID
+        * @return double The score (0 if the airport is not in the scores)
+        */
+        double getScore(int id) const;
+
+        /**
+        * @brief Gets how many sources the last build or update searched from
+        *
+        * @return int The number of sources
+        */
+        int sourcesUpdated() const { return sources_updated_; }
+
+        /**
+        * @brief Gets the memory the scores and dependencies hold
+        *
+        * @return size_t The size in bytes
+        */
+        size_t bytes() const;
+
+        /**
+        * @brief Determines if the scores were made for a snapshot
+        *
+        * @param csr The snapshot to check
+        * @return bool Whether the scores match the snapshot
+        */
+        bool matches(const CSRGraph& csr) const { return csr.fingerprint() == fingerprint_; }
+
+    private:
+        /**
+        * @brief One airport's share of a source's shortest paths
+        */
+        struct Dependency {
+            int airport; // dense index
+            double delta;
+        };
+
+        /**
+        * @brief Adds or cuts a route and searches again from the sources it affects
+        *
+        * @param graph The graph the scores were built from
+        * @param id1 The ID of the route's origin
+        * @param id2 The ID of the route's destination
+        * @param adding Whether the route is added (true) or cut (false)
+        * @param threads How many threads to search from sources on
+        * @return bool Whether the graph was changed
+        */
+        bool _update(Graph& graph, int id1, int id2, bool adding, int threads);
+
+        /**
+        * @brief Searches from sources, replacing their dependencies and patching the scores in source order
+        *
+        * @param csr The snapshot to search
+        * @param sources The sources' dense indices, increasing
+        * @param threads How many threads to search from sources on
+        */
+        void _recompute(const CSRGraph& csr, const vector<int>& sources, int threads);
+
+        bool weighted_;
+        uint64_t fingerprint_; // the fingerprint of the snapshot the scores belong to
+        vector<int> ids_; // the snapshot's airport IDs, by dense index
+        vector<double> scores_; // by dense index
+        vector<vector<Dependency>> dependencies_; // each source's nonzero dependencies
+        int sources_updated_; // the sources searched by the last build or update
+};
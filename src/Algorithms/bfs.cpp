@@ -1,30 +1,178 @@
 #include "bfs.h"
+#include "../SearchWorkspace.h"
+#include "../Parallel.h"
+#include <atomic>
+#include <memory>
+#include <algorithm>
 
 using namespace std;
 
-vector<int> BFS::traversalOfBFS(const Graph& g, int startID) {
+vector<int> BFS::traversalOfBFS(const Graph& g, int startID, const SearchMask* mask) {
 	pathOfBFS_.clear();
-	setAllFalse(g);
-	queued_.push(startID);
-	visited_[startID] = true;
-	while(!queued_.empty()) {
-		int present = queued_.front();
-		queued_.pop();
-		pathOfBFS_.push_back(present);
-		for (int id : g.getConnections(present)) {
-			if (!visited_[id]) {
-				visited_[id] = true;
-				queued_.push(id);
+	const CSRGraph& csr = g.csr();
+	int start = csr.getIndex(startID);
+	if (start == -1 || (mask && mask->nodeBanned(start))) {
+		return pathOfBFS_;
+	}
+	// the visited marks and queue live in the thread's workspace, so they are reset in O(1)
+	SearchWorkspace& ws = SearchWorkspace::local();
+	ws.reset(csr.size());
+	vector<int>& queued = ws.queue();
+	queued.push_back(start);
+	ws.visit(start);
+	for (size_t front = 0; front < queued.size(); front++) {
+		int present = queued[front];
+		pathOfBFS_.push_back(csr.getID(present));
+		for (int e = csr.outBegin(present); e < csr.outEnd(present); e++) {
+			int id = csr.target(e);
+			if (mask && (mask->edgeBanned(e) || mask->nodeBanned(id))) {
+				continue;
+			}
+			if (!ws.visited(id)) {
+				ws.visit(id);
+				queued.push_back(id);
 			}
 		}
 	}
 	return pathOfBFS_;
 }
 
-void BFS::setAllFalse(const Graph& g) {
-	for (int i : g.getIDs()) {
-		visited_[i] = false;
-	} 
+vector<HopNeighbour> BFS::neighbourhood(const Graph& g, int startID, int maxLegs,
+	const function<bool(int, const vector<int>&)>& onLevel, const SearchMask* mask) {
+	vector<HopNeighbour> found;
+	const CSRGraph& csr = g.csr();
+	int start = csr.getIndex(startID);
+	if (start == -1 || maxLegs < 0 || (mask && mask->nodeBanned(start))) {
+		return found;
+	}
+	// onLevel may run searches of its own (even another neighbourhood), so this traversal takes a workspace
+	// of its own for its depth of nesting rather than the one SearchWorkspace::local() hands to every search
+	static thread_local vector<unique_ptr<SearchWorkspace>> workspaces;
+	static thread_local size_t depth = 0;
+	if (workspaces.size() == depth) {
+		workspaces.push_back(unique_ptr<SearchWorkspace>(new SearchWorkspace()));
+	}
+	struct Nested {
+		Nested() { depth++; }
+		~Nested() { depth--; }
+	} nested;
+	SearchWorkspace& ws = *workspaces[depth - 1];
+	ws.reset(csr.size());
+	vector<int>& queued = ws.queue();
+	queued.push_back(start);
+	ws.visit(start);
+	// each level is queued[levelBegin, levelEnd), and is only expanded if the next one is within the limit
+	size_t levelBegin = 0;
+	vector<int> level;
+	for (int legs = 0; levelBegin < queued.size(); legs++) {
+		size_t levelEnd = queued.size();
+		level.clear();
+		for (size_t i = levelBegin; i < levelEnd; i++) {
+			found.push_back(HopNeighbour{csr.getID(queued[i]), legs});
+			level.push_back(found.back().id);
+		}
+		if ((onLevel && !onLevel(legs, level)) || legs == maxLegs) {
+			break;
+		}
+		for (size_t i = levelBegin; i < levelEnd; i++) {
+			int present = queued[i];
+			for (int e = csr.outBegin(present); e < csr.outEnd(present); e++) {
+				int id = csr.target(e);
+				if (mask && (mask->edgeBanned(e) || mask->nodeBanned(id))) {
+					continue;
+				}
+				if (!ws.visited(id)) {
+					ws.visit(id);
+					queued.push_back(id);
+				}
+			}
+		}
+		levelBegin = levelEnd;
+	}
+	return found;
+}
+
+vector<int> BFS::parallelTraversalOfBFS(const Graph& g, int startID, int threads, const SearchMask* mask) {
+	pathOfBFS_.clear();
+	const CSRGraph& csr = g.csr();
+	int start = csr.getIndex(startID);
+	if (start == -1 || (mask && mask->nodeBanned(start))) {
+		return pathOfBFS_;
+	}
+	if (threads <= 0) {
+		threads = defaultThreads();
+	}
+	int n = csr.size();
+	int words = (n + 63) / 64;
+	unique_ptr<atomic<uint64_t>[]> visited(new atomic<uint64_t>[words]);
+	for (int w = 0; w < words; w++) {
+		visited[w].store(0, memory_order_relaxed);
+	}
+	// sets an airport's bit, and tells whether this thread was the one that set it
+	auto claim = [&](int v) {
+		atomic<uint64_t>& word = visited[v >> 6];
+		uint64_t bit = uint64_t(1) << (v & 63);
+		uint64_t old = word.load(memory_order_relaxed);
+		while (!(old & bit)) {
+			if (word.compare_exchange_weak(old, old | bit, memory_order_relaxed)) {
+				return true;
+			}
+		}
+		return false;
+	};
+	claim(start);
+
+	// every level is appended to order, so the current level is order[levelBegin, levelEnd)
+	vector<int> order(n);
+	order[0] = start;
+	size_t levelBegin = 0, levelEnd = 1;
+	vector<vector<int>> next(threads);
+	vector<size_t> offsets(threads + 1, 0);
+	atomic<size_t> position(0);
+	Barrier barrier(threads);
+	runTeam(threads, [&](int t) {
+		const size_t CHUNK = 64;
+		while (true) {
+			for (size_t begin = position.fetch_add(CHUNK); begin < levelEnd; begin = position.fetch_add(CHUNK)) {
+				size_t end = min(begin + CHUNK, levelEnd);
+				for (size_t i = begin; i < end; i++) {
+					int present = order[i];
+					for (int e = csr.outBegin(present); e < csr.outEnd(present); e++) {
+						int id = csr.target(e);
+						if (mask && (mask->edgeBanned(e) || mask->nodeBanned(id))) {
+							continue;
+						}
+						if (claim(id)) {
+							next[t].push_back(id);
+						}
+					}
+				}
+			}
+			offsets[t + 1] = next[t].size();
+			barrier.wait();
+			if (t == 0) {
+				for (int i = 0; i < threads; i++) {
+					offsets[i + 1] += offsets[i];
+				}
+				levelBegin = levelEnd;
+				levelEnd += offsets[threads];
+				position = levelBegin;
+			}
+			barrier.wait();
+			if (offsets[threads] == 0) {
+				break;
+			}
+			copy(next[t].begin(), next[t].end(), order.begin() + levelBegin + offsets[t]);
+			next[t].clear();
+			barrier.wait();
+		}
+	});
+
+	pathOfBFS_.resize(levelEnd);
+	for (size_t i = 0; i < levelEnd; i++) {
+		pathOfBFS_[i] = csr.getID(order[i]);
+	}
+	return pathOfBFS_;
 }
 
 vector<int> BFS::getPath() {
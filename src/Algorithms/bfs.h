@@ -1,11 +1,21 @@
 #pragma once
 #include "../Graph.h"
+#include "../CSRGraph.h"
+#include "../SearchMask.h"
 #include <vector>
-#include <map>
-#include <queue>
+#include <functional>
 
 
 using namespace std;
+
+/**
+ * @brief An airport found by BFS::neighbourhood, with the fewest legs needed to reach it
+ */
+struct HopNeighbour {
+    int id;
+    int legs;
+};
+
 class BFS {
     public:
     /**
@@ -13,39 +23,56 @@ class BFS {
     *
     * @param g the given graph to traverse through
     * @param startID the starting point of traversal
+    * @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
     * @return a vector of all ids in order of when they were visited
     */
-    vector<int> traversalOfBFS(const Graph& g, int startID);
+    vector<int> traversalOfBFS(const Graph& g, int startID, const SearchMask* mask = nullptr);
 
     /**
-    * @brief gets the path of the traversal
+    * @brief Traverses through the graph level by level, spreading each level over worker threads
+    * Each thread takes chunks of the current level, claims the airports it reaches by an atomic
+    * compare-and-swap on a shared visited bitmap and appends them to its own list for the next level;
+    * the lists are joined once every thread is done with the level. Visits the same airports as
+    * traversalOfBFS, level by level, but the order within a level depends on the threads (with one
+    * thread it is exactly traversalOfBFS's order)
     *
+    * @param g the given graph to traverse through
+    * @param startID the starting point of traversal
+    * @param threads how many threads to use (0 for all hardware threads)
+    * @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
     * @return a vector of all ids in order of when they were visited
     */
-    vector<int> getPath();
-
-
-    private:
+    vector<int> parallelTraversalOfBFS(const Graph& g, int startID, int threads = 0, const SearchMask* mask = nullptr);
 
     /**
-    * @brief stores the queued ids for traversal
+    * @brief Finds every airport within a number of legs of a starting airport
+    * Stops expanding at the limit, and the visited marks and queue live in a workspace kept by the thread for
+    * this search, so a small radius costs only the size of the neighbourhood rather than of the whole reachable
+    * component. The callback may run any other search, including another neighbourhood
+    *
+    * @param g the given graph to traverse through
+    * @param startID the starting point of traversal
+    * @param maxLegs the most legs to go (0 gives only the start)
+    * @param onLevel if given, called with each level's number and airport IDs once the level is complete;
+    * returning false stops the search after that level
+    * @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
+    * @return every airport found with its legs, in the order traversalOfBFS visits them (empty if the start is
+    * not in the graph or is banned)
     */
-    queue<int> queued_;
+    vector<HopNeighbour> neighbourhood(const Graph& g, int startID, int maxLegs,
+        const function<bool(int, const vector<int>&)>& onLevel = nullptr, const SearchMask* mask = nullptr);
 
     /**
-    * @brief stores data of weather or not the id's were visited
+    * @brief gets the path of the traversal
+    *
+    * @return a vector of all ids in order of when they were visited
     */
-    map<int, bool> visited_;
+    vector<int> getPath();
 
-    /**
-    * @brief stores the list of ids visited through BFS
-    */
-    vector<int> pathOfBFS_;
+
+    private:
 
     /**
-    * @brief a helper function to set all nodes as n ot visited
-    *
-    * @param g the given graph to set nodes for
+    * @brief stores the list of ids visited through BFS
     */
-    void setAllFalse(const Graph& g);
-};
+    vector<int> pathOfBFS_;};
@@ -0,0 +1,422 @@
+#include "contraction.h"
+#include <queue>
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace {
+    /**
+    * @brief A connection while the hierarchy is being built
+    */
+    struct Arc {
+        int other; // the airport at the other end
+        double weight; // the distance
+        int middle; // the airport a shortcut skips over, or -1 for an original connection
+    };
+
+    /**
+    * @brief A shortcut found while contracting an airport
+    */
+    struct Shortcut {
+        int from, to;
+        double weight;
+    };
+
+    /**
+    * @brief The state of the graph during contraction
+    */
+    class Contractor {
+        public:
+            Contractor(const CSRGraph& csr, int maxSettled) : n_(csr.size()), maxSettled_(maxSettled),
+                out_(n_), in_(n_), deleted_(n_, 0), level_(n_, 0),
+                witnessDist_(n_, numeric_limits<double>::infinity()), isTarget_(n_, false) {
+                for (int u = 0; u < n_; u++) {
+                    for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+                        out_[u].push_back(Arc{csr.target(e), csr.weight(e), -1});
+                        in_[csr.target(e)].push_back(Arc{u, csr.weight(e), -1});
+                    }
+                }
+            }
+
+            /**
+            * @brief Finds the shortcuts contracting an airport would need
+            *
+            * @param v The airport to contract
+            * @param shortcuts Filled with the shortcuts
+            * @param maxSettled How many airports each witness search may settle
+            */
+            void findShortcuts(int v, vector<Shortcut>& shortcuts, int maxSettled) {
+                shortcuts.clear();
+                for (const Arc& in : in_[v]) {
+                    double maxVia = -1;
+                    for (const Arc& out : out_[v]) {
+                        if (out.other != in.other) { maxVia = max(maxVia, in.weight + out.weight); }
+                    }
+                    if (maxVia < 0) { continue; }
+                    int targets = 0;
+                    for (const Arc& out : out_[v]) {
+                        if (out.other != in.other && !isTarget_[out.other]) {
+                            isTarget_[out.other] = true;
+                            targets++;
+                        }
+                    }
+                    _witnessSearch(in.other, v, maxVia, maxSettled, targets);
+                    for (const Arc& out : out_[v]) { isTarget_[out.other] = false; }
+                    for (const Arc& out : out_[v]) {
+                        if (out.other == in.other) { continue; }
+                        double via = in.weight + out.weight;
+                        // an equally short path that avoids v is a witness, so no shortcut is needed
+                        if (witnessDist_[out.other] > via) {
+                            shortcuts.push_back(Shortcut{in.other, out.other, via});
+                        }
+                    }
+                    _resetWitness();
+                }
+            }
+
+            /**
+            * @brief Calculates how important an airport is; the least important is contracted first
+            *
+            * @param v The airport
+            * @return int The priority
+            */
+            int priority(int v) {
+                // estimating with short witness searches is much cheaper and ranks airports nearly as well
+                findShortcuts(v, scratch_, max(1, maxSettled_ / 10));
+                int edgeDifference = (int)scratch_.size() - (int)in_[v].size() - (int)out_[v].size();
+                return 2 * edgeDifference + deleted_[v] + level_[v];
+            }
+
+            /**
+            * @brief Contracts an airport, recording its remaining connections as hierarchy connections
+            *
+            * @param v The airport to contract
+            * @param up Filled with v's connections to uncontracted airports
+            * @param down Filled with connections from uncontracted airports to v
+            * @return int How many new shortcuts were added
+            */
+            int contract(int v, vector<Arc>& up, vector<Arc>& down) {
+                findShortcuts(v, scratch_, maxSettled_);
+                up = out_[v];
+                down = in_[v];
+                for (const Arc& arc : out_[v]) { _erase(in_[arc.other], v); }
+                for (const Arc& arc : in_[v]) { _erase(out_[arc.other], v); }
+                int added = 0;
+                for (const Shortcut& shortcut : scratch_) {
+                    added += _addShortcut(shortcut, v);
+                }
+                for (const Arc& arc : up) { _touchNeighbor(arc.other, v); }
+                for (const Arc& arc : down) { _touchNeighbor(arc.other, v); }
+                out_[v].clear();
+                in_[v].clear();
+                return added;
+            }
+
+        private:
+            /**
+            * @brief Dijkstra search from source among uncontracted airports, skipping one airport
+            * Stops once the search passes limit, has settled maxSettled airports, or has settled every target
+            */
+            void _witnessSearch(int source, int skip, double limit, int maxSettled, int targets) {
+                typedef pair<double, int> QueueNode;
+                priority_queue<QueueNode, vector<QueueNode>, greater<QueueNode>> qu;
+                witnessDist_[source] = 0;
+                witnessTouched_.push_back(source);
+                qu.push(QueueNode(0, source));
+                int settled = 0;
+                while (!qu.empty() && settled < maxSettled) {
+                    QueueNode node = qu.top();
+                    qu.pop();
+                    if (node.first > witnessDist_[node.second]) { continue; }
+                    if (node.first > limit) { break; }
+                    settled++;
+                    if (isTarget_[node.second] && --targets == 0) { break; }
+                    for (const Arc& arc : out_[node.second]) {
+                        if (arc.other == skip) { continue; }
+                        double alt = node.first + arc.weight;
+                        if (alt < witnessDist_[arc.other]) {
+                            if (witnessDist_[arc.other] == numeric_limits<double>::infinity()) {
+                                witnessTouched_.push_back(arc.other);
+                            }
+                            witnessDist_[arc.other] = alt;
+                            qu.push(QueueNode(alt, arc.other));
+                        }
+                    }
+                }
+            }
+
+            void _resetWitness() {
+                for (int v : witnessTouched_) { witnessDist_[v] = numeric_limits<double>::infinity(); }
+                witnessTouched_.clear();
+            }
+
+            static void _erase(vector<Arc>& arcs, int other) {
+                for (size_t i = 0; i < arcs.size(); i++) {
+                    if (arcs[i].other == other) {
+                        arcs[i] = arcs.back();
+                        arcs.pop_back();
+                        return;
+                    }
+                }
+            }
+
+            /**
+            * @brief Adds a shortcut, or shortens an existing connection between the same airports
+            * @return int 1 if a new connection was added, 0 otherwise
+            */
+            int _addShortcut(const Shortcut& shortcut, int middle) {
+                for (Arc& arc : out_[shortcut.from]) {
+                    if (arc.other != shortcut.to) { continue; }
+                    if (shortcut.weight < arc.weight) {
+                        arc.weight = shortcut.weight;
+                        arc.middle = middle;
+                        for (Arc& back : in_[shortcut.to]) {
+                            if (back.other == shortcut.from) {
+                                back.weight = shortcut.weight;
+                                back.middle = middle;
+                            }
+                        }
+                    }
+                    return 0;
+                }
+                out_[shortcut.from].push_back(Arc{shortcut.to, shortcut.weight, middle});
+                in_[shortcut.to].push_back(Arc{shortcut.from, shortcut.weight, middle});
+                return 1;
+            }
+
+            void _touchNeighbor(int neighbor, int contracted) {
+                deleted_[neighbor]++;
+                level_[neighbor] = max(level_[neighbor], level_[contracted] + 1);
+            }
+
+            int n_;
+            int maxSettled_;
+            vector<vector<Arc>> out_, in_;
+            vector<int> deleted_, level_;
+            vector<double> witnessDist_;
+            vector<bool> isTarget_;
+            vector<int> witnessTouched_;
+            vector<Shortcut> scratch_;
+    };
+}
+
+void ContractionHierarchy::build(const Graph& g, int maxSettled) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    fingerprint_ = csr.fingerprint();
+    ids_ = csr.getIDs();
+    weak_.resize(n);
+    strong_.resize(n);
+    for (int v = 0; v < n; v++) {
+        weak_[v] = csr.weakComponent(v);
+        strong_[v] = csr.strongComponent(v);
+    }
+    rank_.assign(n, -1);
+    shortcuts_ = 0;
+
+    Contractor contractor(csr, maxSettled);
+    typedef pair<int, int> QueueNode;
+    priority_queue<QueueNode, vector<QueueNode>, greater<QueueNode>> qu;
+    vector<int> current(n);
+    for (int v = 0; v < n; v++) {
+        current[v] = contractor.priority(v);
+        qu.push(QueueNode(current[v], v));
+    }
+
+    vector<vector<Arc>> up(n), down(n);
+    int contracted = 0;
+    while (!qu.empty()) {
+        QueueNode node = qu.top();
+        qu.pop();
+        int v = node.second;
+        if (rank_[v] != -1 || node.first != current[v]) { continue; }
+        // lazy update: priorities go stale as neighbors are contracted, so each one is
+        // recomputed when it reaches the top and put back if it is no longer the smallest
+        int fresh = contractor.priority(v);
+        if (fresh != current[v]) {
+            current[v] = fresh;
+            if (!qu.empty() && fresh > qu.top().first) {
+                qu.push(QueueNode(fresh, v));
+                continue;
+            }
+        }
+        rank_[v] = contracted++;
+        shortcuts_ += contractor.contract(v, up[v], down[v]);
+    }
+
+    // flattens the hierarchy connections into CSR arrays
+    upOffsets_.assign(n + 1, 0);
+    downOffsets_.assign(n + 1, 0);
+    upTargets_.clear(); upWeights_.clear(); upMiddles_.clear();
+    downSources_.clear(); downWeights_.clear(); downMiddles_.clear();
+    for (int v = 0; v < n; v++) {
+        for (const Arc& arc : up[v]) {
+            upTargets_.push_back(arc.other);
+            upWeights_.push_back(arc.weight);
+            upMiddles_.push_back(arc.middle);
+        }
+        for (const Arc& arc : down[v]) {
+            downSources_.push_back(arc.other);
+            downWeights_.push_back(arc.weight);
+            downMiddles_.push_back(arc.middle);
+        }
+        upOffsets_[v + 1] = upTargets_.size();
+        downOffsets_[v + 1] = downSources_.size();
+    }
+
+    forwardDist_.assign(n, numeric_limits<double>::infinity());
+    backwardDist_.assign(n, numeric_limits<double>::infinity());
+    forwardParent_.assign(n, -1);
+    backwardParent_.assign(n, -1);
+    touched_.clear();
+}
+
+int ContractionHierarchy::getIndex(int id) const {
+    auto it = lower_bound(ids_.begin(), ids_.end(), id);
+    if (it == ids_.end() || *it != id) {
+        return -1;
+    }
+    return it - ids_.begin();
+}
+
+double ContractionHierarchy::_search(int s, int t) {
+    double inf = numeric_limits<double>::infinity();
+    for (int v : touched_) {
+        forwardDist_[v] = backwardDist_[v] = inf;
+        forwardParent_[v] = backwardParent_[v] = -1;
+    }
+    touched_.clear();
+    settled_ = 0;
+    meet_ = -1;
+
+    typedef pair<double, int> QueueNode;
+    priority_queue<QueueNode, vector<QueueNode>, greater<QueueNode>> forward, backward;
+    forwardDist_[s] = 0;
+    backwardDist_[t] = 0;
+    touched_.push_back(s);
+    touched_.push_back(t);
+    forward.push(QueueNode(0, s));
+    backward.push(QueueNode(0, t));
+    double best = inf;
+
+    bool forwardTurn = true;
+    while (true) {
+        // a direction is finished once it can no longer improve on the best meeting point
+        if (!forward.empty() && forward.top().first >= best) { forward = decltype(forward)(); }
+        if (!backward.empty() && backward.top().first >= best) { backward = decltype(backward)(); }
+        if (forward.empty() && backward.empty()) { break; }
+        if (forward.empty()) { forwardTurn = false; }
+        if (backward.empty()) { forwardTurn = true; }
+
+        auto& qu = forwardTurn ? forward : backward;
+        vector<double>& dist = forwardTurn ? forwardDist_ : backwardDist_;
+        vector<double>& otherDist = forwardTurn ? backwardDist_ : forwardDist_;
+        vector<int>& parent = forwardTurn ? forwardParent_ : backwardParent_;
+        QueueNode node = qu.top();
+        qu.pop();
+        int v = node.second;
+        bool wasForward = forwardTurn;
+        forwardTurn = !forwardTurn;
+        if (node.first > dist[v]) { continue; }
+        settled_++;
+        if (otherDist[v] < inf && node.first + otherDist[v] < best) {
+            best = node.first + otherDist[v];
+            meet_ = v;
+        }
+
+        // stall-on-demand: if a higher airport reaches v more cheaply, v's distance is not
+        // a real shortest distance, so searching on from it is wasted work
+        bool stalled = false;
+        int begin = wasForward ? downOffsets_[v] : upOffsets_[v];
+        int end = wasForward ? downOffsets_[v + 1] : upOffsets_[v + 1];
+        for (int a = begin; a < end && !stalled; a++) {
+            int other = wasForward ? downSources_[a] : upTargets_[a];
+            double weight = wasForward ? downWeights_[a] : upWeights_[a];
+            stalled = dist[other] + weight < node.first;
+        }
+        if (stalled) { continue; }
+
+        begin = wasForward ? upOffsets_[v] : downOffsets_[v];
+        end = wasForward ? upOffsets_[v + 1] : downOffsets_[v + 1];
+        for (int a = begin; a < end; a++) {
+            int other = wasForward ? upTargets_[a] : downSources_[a];
+            double alt = node.first + (wasForward ? upWeights_[a] : downWeights_[a]);
+            if (alt < dist[other]) {
+                if (forwardDist_[other] == inf && backwardDist_[other] == inf) { touched_.push_back(other); }
+                dist[other] = alt;
+                parent[other] = v;
+                qu.push(QueueNode(alt, other));
+            }
+        }
+    }
+    return best;
+}
+
+double ContractionHierarchy::getDistance(int source, int target) {
+    shortestDistance_ = numeric_limits<double>::infinity();
+    int s = getIndex(source);
+    int t = getIndex(target);
+    settled_ = 0;
+    // the same test as CSRGraph::mayReach, since no path can leave a weak component or climb the strong ones
+    if (s == -1 || t == -1 || weak_[s] != weak_[t] || strong_[s] < strong_[t]) {
+        return shortestDistance_;
+    }
+    shortestDistance_ = _search(s, t);
+    return shortestDistance_;
+}
+
+vector<int> ContractionHierarchy::getPath(int source, int target) {
+    getDistance(source, target);
+    if (shortestDistance_ == numeric_limits<double>::infinity()) {
+        return vector<int>();
+    }
+    int s = getIndex(source);
+
+    // the upward halves of the path, from s to the meeting point and from the meeting point to t
+    vector<int> forwardHalf, backwardHalf;
+    for (int v = meet_; v != -1; v = forwardParent_[v]) { forwardHalf.push_back(v); }
+    reverse(forwardHalf.begin(), forwardHalf.end());
+    for (int v = backwardParent_[meet_]; v != -1; v = backwardParent_[v]) { backwardHalf.push_back(v); }
+
+    vector<int> indices(1, s);
+    int previous = meet_;
+    for (size_t i = 1; i < forwardHalf.size(); i++) {
+        unpack(forwardHalf[i - 1], forwardHalf[i], indices);
+    }
+    for (int v : backwardHalf) {
+        unpack(previous, v, indices);
+        previous = v;
+    }
+
+    vector<int> path;
+    for (int v : indices) { path.push_back(ids_[v]); }
+    return path;
+}
+
+void ContractionHierarchy::unpack(int from, int to, vector<int>& path) const {
+    // explicit stack of connections still to expand, last one on top
+    vector<pair<int, int>> stack(1, make_pair(from, to));
+    while (!stack.empty()) {
+        pair<int, int> arc = stack.back();
+        stack.pop_back();
+        int a = arc.first, b = arc.second;
+        // the connection is stored at whichever end was contracted first
+        int middle = -1;
+        if (rank_[a] < rank_[b]) {
+            for (int i = upOffsets_[a]; i < upOffsets_[a + 1]; i++) {
+                if (upTargets_[i] == b) { middle = upMiddles_[i]; break; }
+            }
+        } else {
+            for (int i = downOffsets_[b]; i < downOffsets_[b + 1]; i++) {
+                if (downSources_[i] == a) { middle = downMiddles_[i]; break; }
+            }
+        }
+        if (middle == -1) {
+            path.push_back(b);
+        } else {
+            stack.push_back(make_pair(middle, b));
+            stack.push_back(make_pair(a, middle));
+        }
+    }
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Class for Contraction Hierarchies
+ * Preprocesses a graph by contracting airports one at a time from least to most important,
+ * adding shortcut connections that preserve shortest distances between the remaining airports.
+ * Queries then only search upwards in the hierarchy from both ends, which settles a tiny
+ * fraction of the airports a Dijkstra search would
+ */
+class ContractionHierarchy {
+    public:
+        /**
+        * @brief Constructs an empty hierarchy (queries find no paths until built)
+        */
+        ContractionHierarchy() : fingerprint_(0), shortcuts_(0), meet_(-1),
+            shortestDistance_(numeric_limits<double>::infinity()), settled_(0) {}
+
+        /**
+        * @brief Contracts every airport of a graph, building the hierarchy
+        *
+        * @param g The graph to preprocess
+        * @param maxSettled How many airports a witness search may settle before giving up
+        * (smaller is faster to build but adds more shortcuts)
+        */
+        void build(const Graph& g, int maxSettled = 100);
+
+        /**
+        * @brief Generates the shortest path of airports from source to target
+        * Shortcuts are unpacked, so the path is the same format as Dijkstras::getPath
+        *
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @return chronological vector of airport IDs from source to target (empty if there is no path)
+        */
+        vector<int> getPath(int source, int target);
+
+        /**
+        * @brief Finds the shortest distance from source to target without unpacking the path
+        *
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @return The distance between the airports, or infinity if there is no path
+        */
+        double getDistance(int source, int target);
+
+        /**
+        * @brief shortest distance of the last query
+        * @return The distance between the airports, or infinity if there is no path
+        */
+        double shortestDistance() const { return shortestDistance_; }
+
+        /**
+        * @brief number of airports settled by the last query
+        * @return The number of settled airports
+        */
+        int settledCount() const { return settled_; }
+
+        /**
+        * @brief Gets the number of shortcuts the preprocessing added
+        * @return The number of shortcuts
+        */
+        int shortcutCount() const { return shortcuts_; }
+
+        /**
+        * @brief Gets the number of connections in the hierarchy (original plus shortcuts)
+        * @return The number of connections
+        */
+        int hierarchyEdges() const { return upTargets_.size() + downSources_.size(); }
+
+        /**
+        * @brief Gets the number of airports in the hierarchy
+        * @return The number of airports
+        */
+        int size() const { return ids_.size(); }
+
+        /**
+        * @brief Determines if the hierarchy was built for a snapshot
+        *
+        * @param csr The snapshot to check
+        * @return bool Whether the hierarchy matches the snapshot
+        */
+        bool matches(const CSRGraph& csr) const { return !ids_.empty() && csr.fingerprint() == fingerprint_; }
+
+        /**
+        * @brief Gets the dense index of an airport ID (the same index as in the graph's CSRGraph)
+        *
+        * @param id The airport's ID
+        * @return int The dense index, or -1 if the airport is not in the hierarchy
+        */
+        int getIndex(int id) const;
+
+        /**
+        * @brief Gets the airport ID of a dense index
+        *
+        * @param index The dense index
+        * @return int The airport's ID
+        */
+        int getID(int index) const { return ids_[index]; }
+
+        /**
+        * @brief Gets the first upward connection of an airport
+        * Upward connections lead to airports contracted later; they are the only ones a forward query follows
+        *
+        * @param index The airport's dense index
+        * @return int The first upward connection
+        */
+        int upBegin(int index) const { return upOffsets_[index]; }
+        /**
+        * @brief Gets one past the last upward connection of an airport
+        *
+        * @param index The airport's dense index
+        * @return int One past the last upward connection
+        */
+        int upEnd(int index) const { return upOffsets_[index + 1]; }
+        /**
+        * @brief Gets the destination of an upward connection
+        *
+        * @param arc The upward connection
+        * @return int The destination's dense index
+        */
+        int upTarget(int arc) const { return upTargets_[arc]; }
+        /**
+        * @brief Gets the distance of an upward connection
+        *
+        * @param arc The upward connection
+        * @return double The distance
+        */
+        double upWeight(int arc) const { return upWeights_[arc]; }
+        /**
+        * @brief Gets the first downward connection of an airport
+        * Downward connections of an airport come from airports contracted later; a backward query follows them
+        *
+        * @param index The airport's dense index
+        * @return int The first downward connection
+        */
+        int downBegin(int index) const { return downOffsets_[index]; }
+        /**
+        * @brief Gets one past the last downward connection of an airport
+        *
+        * @param index The airport's dense index
+        * @return int One past the last downward connection
+        */
+        int downEnd(int index) const { return downOffsets_[index + 1]; }
+        /**
+        * @brief Gets the origin of a downward connection
+        *
+        * @param arc The downward connection
+        * @return int The origin's dense index
+        */
+        int downSource(int arc) const { return downSources_[arc]; }
+        /**
+        * @brief Gets the distance of a downward connection
+        *
+        * @param arc The downward connection
+        * @return double The distance
+        */
+        double downWeight(int arc) const { return downWeights_[arc]; }
+
+        /**
+        * @brief Appends the airports along a hierarchy connection, excluding its origin
+        * Shortcuts are expanded recursively into the original connections they stand for
+        *
+        * @param from The connection's origin (dense index)
+        * @param to The connection's destination (dense index)
+        * @param path The path to append dense indices to
+        */
+        void unpack(int from, int to, vector<int>& path) const;
+
+    private:
+        /**
+        * @brief Runs the bidirectional upward search, leaving the meeting point in meet_
+        *
+        * @param s The source's dense index
+        * @param t The target's dense index
+        * @return double The shortest distance
+        */
+        double _search(int s, int t);
+
+        uint64_t fingerprint_; // fingerprint of the snapshot the hierarchy was built for
+        int shortcuts_; // number of shortcuts added
+        vector<int> ids_; // airport ID of each dense index
+        vector<int> rank_; // contraction order of each airport
+        vector<int> weak_, strong_; // each airport's components in the snapshot, so pairs with no path are rejected in O(1)
+
+        vector<int> upOffsets_, upTargets_, upMiddles_; // connections to higher airports, by origin
+        vector<double> upWeights_;
+        vector<int> downOffsets_, downSources_, downMiddles_; // connections from higher airports, by destination
+        vector<double> downWeights_;
+
+        // query state, reused between queries and reset through the touched list
+        vector<double> forwardDist_, backwardDist_;
+        vector<int> forwardParent_, backwardParent_;
+        vector<int> touched_;
+        int meet_;
+
+        double shortestDistance_; // shortest distance of the last query
+        int settled_; // airports settled by the last query
+};
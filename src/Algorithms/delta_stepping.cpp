@@ -0,0 +1,139 @@
+#include "delta_stepping.h"
+#include "../Parallel.h"
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <memory>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+    /**
+    * @brief The most buckets that may hold airports at once, which limits how small delta can be
+    */
+    const double MAX_BUCKET_SPAN = 1 << 16;
+
+    /**
+    * @brief A thread's own buckets and the airports it settled in the current bucket
+    * Bucket i is kept in buckets[i % buckets.size()]: no airport is ever put more than the longest connection past
+    * the bucket being emptied, so the buckets in use never wrap around onto each other
+    */
+    struct Worker {
+        vector<vector<int>> buckets;
+        size_t lowest = 0; // no bucket below this one holds anything
+        size_t queued = 0; // the number of airports waiting in any bucket
+        vector<int> settled;
+    };
+}
+
+void deltaStepping(const CSRGraph& csr, int source, vector<double>& distances, double delta, int threads) {
+    double inf = numeric_limits<double>::infinity();
+    int n = csr.size();
+    distances.assign(n, inf);
+    if (source < 0 || source >= n) { return; }
+    if (threads <= 0) { threads = defaultThreads(); }
+    double total = 0, longest = 0;
+    for (int e = 0; e < csr.edges(); e++) {
+        total += csr.weight(e);
+        longest = max(longest, csr.weight(e));
+    }
+    if (delta <= 0) {
+        delta = csr.edges() > 0 && total > 0 ? total / csr.edges() : 1;
+    }
+    // a tiny delta would need a bucket for every sliver of the longest connection
+    delta = max(delta, longest / MAX_BUCKET_SPAN);
+    size_t span = (size_t)ceil(longest / delta) + 2;
+
+    unique_ptr<atomic<double>[]> dist(new atomic<double>[n]);
+    unique_ptr<atomic<int>[]> settledIn(new atomic<int>[n]); // the last bucket each airport was settled in
+    for (int v = 0; v < n; v++) {
+        dist[v].store(inf, memory_order_relaxed);
+        settledIn[v].store(-1, memory_order_relaxed);
+    }
+
+    vector<Worker> workers(threads);
+    for (Worker& worker : workers) { worker.buckets.resize(span); }
+    const size_t NONE = numeric_limits<size_t>::max();
+    size_t bucket = 0; // the bucket being emptied
+    vector<size_t> proposals(threads), offsets(threads + 1);
+    vector<int> frontier;
+    atomic<size_t> next(0);
+    Barrier barrier(threads);
+
+    // lowers an airport's distance if the new one is shorter, and puts it in its new bucket
+    auto relax = [&](Worker& worker, int v, double distance) {
+        double old = dist[v].load(memory_order_relaxed);
+        while (distance < old) {
+            if (dist[v].compare_exchange_weak(old, distance)) {
+                size_t index = distance / delta;
+                worker.buckets[index % span].push_back(v);
+                worker.queued++;
+                worker.lowest = min(worker.lowest, index);
+                return;
+            }
+        }
+    };
+    relax(workers[0], source, 0);
+
+    runTeam(threads, [&](int t) {
+        Worker& worker = workers[t];
+        while (true) {
+            // every thread proposes its lowest non-empty bucket, and the lowest of those is emptied next; nothing is
+            // left below the last bucket emptied, so the search starts there and cannot wrap around
+            worker.lowest = max(worker.lowest, bucket);
+            while (worker.queued > 0 && worker.buckets[worker.lowest % span].empty()) { worker.lowest++; }
+            proposals[t] = worker.queued > 0 ? worker.lowest : NONE;
+            barrier.wait();
+            if (t == 0) { bucket = *min_element(proposals.begin(), proposals.end()); }
+            barrier.wait();
+            if (bucket == NONE) { break; }
+
+            // light rounds: gather the bucket from every thread and relax light connections until it stays empty
+            while (true) {
+                vector<int>& own = worker.buckets[bucket % span];
+                offsets[t + 1] = own.size();
+                barrier.wait();
+                if (t == 0) {
+                    for (int i = 0; i < threads; i++) { offsets[i + 1] += offsets[i]; }
+                    frontier.resize(offsets[threads]);
+                    next = 0;
+                }
+                barrier.wait();
+                if (offsets[threads] == 0) { break; }
+                copy(own.begin(), own.end(), frontier.begin() + offsets[t]);
+                worker.queued -= own.size();
+                own.clear();
+                barrier.wait();
+
+                // airports are handed out in small chunks so the threads stay balanced
+                const size_t CHUNK = 64;
+                for (size_t begin = next.fetch_add(CHUNK); begin < frontier.size(); begin = next.fetch_add(CHUNK)) {
+                    size_t end = min(begin + CHUNK, frontier.size());
+                    for (size_t i = begin; i < end; i++) {
+                        int v = frontier[i];
+                        double d = dist[v].load();
+                        // skips stale copies of airports that have since moved to a lower bucket
+                        if ((size_t)(d / delta) != bucket) { continue; }
+                        if (settledIn[v].exchange(bucket) != (int)bucket) { worker.settled.push_back(v); }
+                        for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+                            if (csr.weight(e) < delta) { relax(worker, csr.target(e), d + csr.weight(e)); }
+                        }
+                    }
+                }
+                barrier.wait();
+            }
+
+            // heavy connections leave the bucket, so they are relaxed once from each settled airport's final distance
+            for (int v : worker.settled) {
+                double d = dist[v].load();
+                for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+                    if (csr.weight(e) >= delta) { relax(worker, csr.target(e), d + csr.weight(e)); }
+                }
+            }
+            worker.settled.clear();
+        }
+    });
+
+    for (int v = 0; v < n; v++) { distances[v] = dist[v].load(); }
+}
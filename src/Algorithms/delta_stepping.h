@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../CSRGraph.h"
+
+#include <vector>
+
+using namespace std;
+
+/**
+* @brief Computes the shortest distance from a source airport to every airport with parallel delta-stepping
+* Airports wait in buckets of width delta by tentative distance. The lowest bucket is emptied in rounds:
+* its airports are spread over the threads, which relax their light connections (shorter than delta)
+* in parallel, refilling the bucket until it stays empty. Heavy connections, which can only lead to later
+* buckets, are then relaxed once for every airport the bucket settled. Distances are lowered with
+* atomic compare-and-swap, and give exactly the same results as shortestDistances
+*
+* @param csr The snapshot to search
+* @param source The source airport's dense index
+* @param distances Filled with each airport's distance (infinity if unreachable)
+* @param delta The bucket width (0 to use the average connection distance); smaller widths do less
+* repeated work per bucket, larger widths give each round more airports to spread over the threads. Widths
+* below 1/65536 of the longest connection are raised to that, so the buckets stay few
+* @param threads How many threads to use (0 for all hardware threads)
+*/
+void deltaStepping(const CSRGraph& csr, int source, vector<double>& distances, double delta = 0, int threads = 0);
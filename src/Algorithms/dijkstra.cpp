@@ -1,80 +1,125 @@
 #include "dijkstra.h"
-#include <queue>
-#include <iostream>
-#include <set>
+#include "../CSRGraph.h"
+#include "../SearchWorkspace.h"
 #include <limits>
 #include <utility>
+#include <functional>
 
 using namespace std;
 
-typedef pair<int, double> DijNode;
+typedef pair<double, int> DijNode;
 
-vector<int> Dijkstras::getPath(const Graph& g, int source, int target) {
-    airports_ = g.getIDs();
-    // checks if source and targets are valid
-    if (!g.inGraph(source) || !g.inGraph(target)) {
-        return vector<int>();
-    }
-    auto comp = [](DijNode a, DijNode b) {
-        return a.second > b.second;
-    };
-    priority_queue<DijNode, vector<DijNode>, decltype(comp)> qu(comp);
-    map<int, double> ports_;
-    map<int, int> prev_;
+vector<int> Dijkstras::getPath(const Graph& g, int source, int target, const SearchMask* mask) {
+    vector<int> path;
+    getPath(g, source, target, path, mask);
+    return path;
+}
 
-    // source to connection distance initialization
-    for (int id : airports_) {
-        if (source == id) {
-            DijNode node(id, 0);
-            qu.push(node);
-            ports_[id] = 0;
-        } else {
-            DijNode node(id, numeric_limits<double>::infinity());
-            qu.push(node);
-            ports_[id] = numeric_limits<double>::infinity();
-        }
-        prev_[id] = -1;
+void Dijkstras::getPath(const Graph& g, int source, int target, vector<int>& path, const SearchMask* mask) {
+    path.clear();
+    shortestDistance_ = numeric_limits<double>::infinity();
+    const CSRGraph& csr = g.csr();
+    int s = csr.getIndex(source);
+    int t = csr.getIndex(target);
+    // checks if source and targets are valid, and that the components allow a path at all
+    if (s == -1 || t == -1 || !csr.mayReach(s, t) || (mask && (mask->nodeBanned(s) || mask->nodeBanned(t)))) {
+        return;
     }
 
-    set<int> seen; // checks if airport has been visited
+    // the distances, previous airports and queue live in the thread's workspace, so nothing is allocated per query
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.reset(csr.size());
+    vector<DijNode>& qu = ws.heap();
+    ws.reach(s, 0, -1);
+    qu.push_back(DijNode(0, s));
 
     while (!qu.empty()) {
-        auto node = qu.top();
-        qu.pop();
-        while (seen.find(node.first) != seen.end() && !qu.empty()) {
-            node = qu.top();
-            qu.pop();
+        DijNode node = qu.front();
+        pop_heap(qu.begin(), qu.end(), greater<DijNode>());
+        qu.pop_back();
+        int v = node.second;
+        if (ws.visited(v)) {
+            continue;
         }
-        seen.insert(node.first);
-        vector<int> neighbors = g.getConnections(node.first);
-        for (int adj : neighbors) {
-            double alt = node.second + g.getDistance(node.first, adj);
-            if (alt < ports_.at(adj)) {
-                ports_[adj] = alt;
-                prev_[adj] = node.first;
-                qu.push(DijNode(adj, alt)); // removed a bunch of adj.first->id
+        ws.visit(v);
+        // the target's distance and previous airport are final once it is visited
+        if (v == t) {
+            break;
+        }
+        for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+            int adj = csr.target(e);
+            if (mask && (mask->edgeBanned(e) || mask->nodeBanned(adj))) {
+                continue;
+            }
+            double alt = node.first + csr.weight(e);
+            if (alt < ws.distance(adj)) {
+                ws.reach(adj, alt, v);
+                qu.push_back(DijNode(alt, adj));
+                push_heap(qu.begin(), qu.end(), greater<DijNode>());
             }
         }
     }
-    // adds previous paths to vector
-    int temp = target;
-    vector<int> paths;
-    while (temp != -1) {
-        paths.push_back(prev_[temp]);
-        temp = prev_.at(temp);
+
+    // checks if no path exists
+    if (!ws.reached(t)) {
+        return;
+    }
+    shortestDistance_ = ws.distance(t);
+    // adds previous airports to the path, then puts it in chronological order
+    for (int v = t; v != -1; v = ws.parent(v)) {
+        path.push_back(csr.getID(v));
+    }
+    reverse(path.begin(), path.end());
+}
+
+vector<int> Dijkstras::getPath(const IntegerGraph& g, int source, int target) {
+    vector<int> path;
+    getPath(g, source, target, path);
+    return path;
+}
+
+void Dijkstras::getPath(const IntegerGraph& g, int source, int target, vector<int>& path) {
+    path.clear();
+    shortestDistance_ = numeric_limits<double>::infinity();
+    int s = g.getIndex(source);
+    int t = g.getIndex(target);
+    if (s == -1 || t == -1 || !g.mayReach(s, t)) {
+        return;
     }
 
-    // reverses path to        
-    reverse(paths.begin(), paths.end());
-    paths.push_back(target);
+    // distances are whole metres, which the workspace's doubles hold exactly
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.reset(g.size());
+    RadixHeap& qu = ws.radixHeap();
+    ws.reach(s, 0, -1);
+    qu.push(0, s);
 
-    shortestDistance_ = ports_[target];
+    while (!qu.empty()) {
+        pair<uint64_t, int> node = qu.pop();
+        int v = node.second;
+        if (ws.visited(v)) {
+            continue;
+        }
+        ws.visit(v);
+        if (v == t) {
+            break;
+        }
+        for (int e = g.outBegin(v); e < g.outEnd(v); e++) {
+            int adj = g.target(e);
+            uint64_t alt = node.first + g.weight(e);
+            if (alt < ws.distance(adj)) {
+                ws.reach(adj, alt, v);
+                qu.push(alt, adj);
+            }
+        }
+    }
 
-    // checks if no path exists
-    if (paths.at(1) != source) {
-        return vector<int>();
+    if (!ws.reached(t)) {
+        return;
     }
-    paths.erase(paths.begin());
-    return paths;
+    shortestDistance_ = ws.distance(t) / 1000;
+    for (int v = t; v != -1; v = ws.parent(v)) {
+        path.push_back(g.getID(v));
+    }
+    reverse(path.begin(), path.end());
 }
-
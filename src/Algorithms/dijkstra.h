@@ -1,12 +1,15 @@
 #pragma once
 
 #include "Graph.h"
+#include "IntegerGraph.h"
+#include "SearchMask.h"
 
 #include <map>
 #include <vector>
 #include <utility>
 #include <algorithm>
 #include <string>
+#include <limits>
 
 #include "readdat.h"
 
@@ -23,35 +26,56 @@ class Dijkstras {
         * @param g network of all airports
         * @param source the source airport ID
         * @param b the target airport ID
+        * @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
         * @return chronological vector of airport IDs from source to target
         */
-        vector<int> getPath(const Graph& g, int source, int target);
+        vector<int> getPath(const Graph& g, int source, int target, const SearchMask* mask = nullptr);
 
         /**
-        * @brief shortest distance of the particular instance
-        * @return The distance between the airports, accounting for the Earth's curvature
+        * @brief Generates a the shortest path of airports from source to target into an existing vector
+        * Reusing the same vector between queries means the search allocates no memory once warmed up
+        * @param g network of all airports
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @param path filled with the chronological airport IDs from source to target (empty if there is no path)
+        * @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
         */
-        double shortestDistance() {
-            return shortestDistance_;
-        }
-
-    private:
+        void getPath(const Graph& g, int source, int target, vector<int>& path, const SearchMask* mask = nullptr);
 
         /**
-        * @brief list of all airports
+        * @brief Generates a the shortest path of airports from source to target using distances rounded to metres
+        * Uses a radix heap instead of a comparison heap, so queue operations are nearly O(1).
+        * See IntegerGraph for how far the path can be from the true shortest path
+        * @param g network of all airports, with rounded distances
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @return chronological vector of airport IDs from source to target
         */
-        vector<int> airports_; 
+        vector<int> getPath(const IntegerGraph& g, int source, int target);
+
         /**
-        * @brief maps source airport connections to its distance
+        * @brief Generates a the shortest path of airports from source to target using distances rounded to metres
+        * into an existing vector
+        * @param g network of all airports, with rounded distances
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @param path filled with the chronological airport IDs from source to target (empty if there is no path)
         */
-        unordered_map<int, double> ports_;
+        void getPath(const IntegerGraph& g, int source, int target, vector<int>& path);
+
         /**
-        * @brief maps airport's previous airport
+        * @brief shortest distance of the particular instance
+        * @return The distance between the airports, accounting for the Earth's curvature
+        * (the sum of the rounded distances, in kilometres, if the last search used an IntegerGraph)
         */
-        map<int, int> prev_; // maps airport's previous immediate source
+        double shortestDistance() {
+            return shortestDistance_;
+        }
+
+    private:
         /**
         * @brief shorteset distance for intended algorithm
         */
-        double shortestDistance_;
+        double shortestDistance_ = numeric_limits<double>::infinity();
       
 };
@@ -0,0 +1,109 @@
+#include "direction_bfs.h"
+#include <algorithm>
+
+using namespace std;
+
+bool DirectionOptimizingBFS::run(const Graph& g, int startID, bool keepOrder, const SearchMask* mask) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    int start = csr.getIndex(startID);
+    levels_.assign(n, -1);
+    parents_.assign(n, -1);
+    order_.clear();
+    topDownSteps_ = bottomUpSteps_ = 0;
+    if (start == -1 || (mask && mask->nodeBanned(start))) { return false; }
+
+    size_t words = (n + 63) / 64;
+    visited_.assign(words, 0);
+    frontierBits_.assign(words, 0);
+    frontier_.assign(1, start);
+    next_.clear();
+    _set(visited_, start);
+    levels_[start] = 0;
+    level_ = 0;
+
+    long long unexplored = csr.edges() - csr.inDegree(start); // incoming connections of the unvisited airports
+    bool bottomUp = false;
+    size_t previous = 0;
+    while (!frontier_.empty()) {
+        if (bottomUp) {
+            bottomUp = frontier_.size() >= previous || frontier_.size() >= n / beta_;
+        } else {
+            long long frontierEdges = 0;
+            for (int v : frontier_) { frontierEdges += csr.outDegree(v); }
+            bottomUp = frontierEdges > unexplored / alpha_;
+        }
+        unexplored -= bottomUp ? _bottomUp(csr, mask) : _topDown(csr, mask);
+        (bottomUp ? bottomUpSteps_ : topDownSteps_)++;
+        previous = frontier_.size();
+        frontier_.swap(next_);
+        next_.clear();
+        level_++;
+    }
+
+    if (keepOrder) { _order(csr, start, mask); }
+    return true;
+}
+
+long long DirectionOptimizingBFS::_topDown(const CSRGraph& csr, const SearchMask* mask) {
+    long long explored = 0;
+    for (int u : frontier_) {
+        for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+            int v = csr.target(e);
+            if (_bit(visited_, v) || (mask && (mask->edgeBanned(e) || mask->nodeBanned(v)))) { continue; }
+            _set(visited_, v);
+            levels_[v] = level_ + 1;
+            parents_[v] = u;
+            next_.push_back(v);
+            explored += csr.inDegree(v);
+        }
+    }
+    return explored;
+}
+
+long long DirectionOptimizingBFS::_bottomUp(const CSRGraph& csr, const SearchMask* mask) {
+    for (int u : frontier_) { _set(frontierBits_, u); }
+    long long explored = 0;
+    int n = csr.size();
+    for (size_t word = 0; word < visited_.size(); word++) {
+        // skips 64 visited airports at a time
+        if (visited_[word] == ~uint64_t(0)) { continue; }
+        int end = min(n, (int)(word + 1) * 64);
+        for (int v = word * 64; v < end; v++) {
+            if (_bit(visited_, v) || (mask && mask->nodeBanned(v))) { continue; }
+            for (int i = csr.inBegin(v); i < csr.inEnd(v); i++) {
+                int u = csr.source(i);
+                if (!_bit(frontierBits_, u) || (mask && mask->edgeBanned(csr.inEdge(i)))) { continue; }
+                levels_[v] = level_ + 1;
+                parents_[v] = u;
+                next_.push_back(v);
+                explored += csr.inDegree(v);
+                break;
+            }
+        }
+    }
+    // marks the new level visited only now, so no airport is found through another airport of its own level
+    for (int v : next_) { _set(visited_, v); }
+    for (int u : frontier_) { frontierBits_[u >> 6] = 0; }
+    return explored;
+}
+
+void DirectionOptimizingBFS::_order(const CSRGraph& csr, int start, const SearchMask* mask) {
+    // the levels are already known, so each airport is placed the first time a parent one level up reaches it
+    vector<int>& queued = frontier_;
+    queued.assign(1, start);
+    fill(visited_.begin(), visited_.end(), 0);
+    _set(visited_, start);
+    for (size_t front = 0; front < queued.size(); front++) {
+        int u = queued[front];
+        order_.push_back(csr.getID(u));
+        for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+            int v = csr.target(e);
+            if (levels_[v] != levels_[u] + 1 || _bit(visited_, v) || (mask && mask->edgeBanned(e))) { continue; }
+            _set(visited_, v);
+            parents_[v] = u;
+            queued.push_back(v);
+        }
+    }
+    queued.clear();
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+#include "../SearchMask.h"
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Class for direction-optimizing breadth-first search (Beamer's algorithm) over a CSR snapshot
+ * Each level is expanded either top-down, where the frontier's airports check their outgoing connections
+ * for unvisited airports, or bottom-up, where every unvisited airport checks its incoming connections for
+ * one in the frontier (a bitmap) and stops at the first. Bottom-up is cheaper once the frontier holds a large
+ * share of the connections left to explore, which in an airport network happens within a couple of levels of
+ * any hub. The search switches to bottom-up when the frontier's outgoing connections exceed the unexplored
+ * airports' incoming connections divided by alpha, and back once the frontier shrinks below size() / beta.
+ *
+ * Gives every airport's level (legs from the start) and a parent on a fewest-legs path. When the visiting
+ * order is requested, it and the parents are made exactly those of BFS::traversalOfBFS
+ */
+class DirectionOptimizingBFS {
+    public:
+        /**
+        * @brief Constructs a search with the switching thresholds
+        *
+        * @param alpha Switches to bottom-up when the frontier's connections exceed the unexplored ones divided by this
+        * @param beta Switches back to top-down when the frontier has fewer airports than the graph divided by this
+        */
+        DirectionOptimizingBFS(double alpha = 14, double beta = 24) : alpha_(alpha), beta_(beta),
+            topDownSteps_(0), bottomUpSteps_(0) {}
+
+        /**
+        * @brief Searches the graph from a starting airport
+        *
+        * @param g the given graph to traverse through
+        * @param startID the starting point of traversal
+        * @param keepOrder whether to record the visiting order of BFS::traversalOfBFS (costs one more top-down pass)
+        * @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
+        * @return bool Whether the search ran (false if the start is not in the graph or is banned)
+        */
+        bool run(const Graph& g, int startID, bool keepOrder = false, const SearchMask* mask = nullptr);
+
+        /**
+        * @brief Gets every airport's level in the last search, by dense index of the graph's snapshot
+        * @return The levels (legs from the start, -1 for airports not reached)
+        */
+        const vector<int>& getLevels() const { return levels_; }
+
+        /**
+        * @brief Gets every airport's parent in the last search, by dense index of the graph's snapshot
+        * @return The parents' dense indices (-1 for the start and airports not reached)
+        */
+        const vector<int>& getParents() const { return parents_; }
+
+        /**
+        * @brief Gets the visiting order of the last search, if it was requested
+        * @return The airport IDs in the order BFS::traversalOfBFS visits them (empty if not requested)
+        */
+        const vector<int>& getOrder() const { return order_; }
+
+        /**
+        * @brief Gets the number of levels the last search expanded top-down
+        * @return The number of levels
+        */
+        int topDownSteps() const { return topDownSteps_; }
+
+        /**
+        * @brief Gets the number of levels the last search expanded bottom-up
+        * @return The number of levels
+        */
+        int bottomUpSteps() const { return bottomUpSteps_; }
+
+    private:
+        /**
+        * @brief Expands the frontier into next by following its airports' outgoing connections
+        *
+        * @param csr The snapshot
+        * @param mask The bans (nullptr for none)
+        * @return long long The incoming connections of the airports newly visited
+        */
+        long long _topDown(const CSRGraph& csr, const SearchMask* mask);
+
+        /**
+        * @brief Expands the frontier into next by checking every unvisited airport's incoming connections
+        *
+        * @param csr The snapshot
+        * @param mask The bans (nullptr for none)
+        * @return long long The incoming connections of the airports newly visited
+        */
+        long long _bottomUp(const CSRGraph& csr, const SearchMask* mask);
+
+        /**
+        * @brief Rebuilds the visiting order and parents of a plain FIFO search over the levels found
+        *
+        * @param csr The snapshot
+        * @param start The start's dense index
+        * @param mask The bans (nullptr for none)
+        */
+        void _order(const CSRGraph& csr, int start, const SearchMask* mask);
+
+        bool _bit(const vector<uint64_t>& bits, int v) const { return (bits[v >> 6] >> (v & 63)) & 1; }
+        void _set(vector<uint64_t>& bits, int v) { bits[v >> 6] |= uint64_t(1) << (v & 63); }
+
+        double alpha_, beta_;
+        int topDownSteps_, bottomUpSteps_;
+        int level_; // the level of the frontier
+        vector<int> levels_, parents_, order_;
+        vector<int> frontier_, next_; // the current and next levels' airports
+        vector<uint64_t> visited_, frontierBits_; // bitmaps over dense indices
+};
@@ -0,0 +1,223 @@
+#include "distance_matrix.h"
+#include "shortest_paths.h"
+#include "../Parallel.h"
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+vector<int> DistanceMatrix::getPath(int row, int column) const {
+    size_t cell = (size_t)row * targets_.size() + column;
+    if (distances_[cell] == numeric_limits<double>::infinity()) {
+        return vector<int>();
+    }
+    vector<int> path;
+    if (!parents_.empty()) {
+        auto it = lower_bound(ids_.begin(), ids_.end(), targets_[column]);
+        for (int v = it - ids_.begin(); v != -1; v = parents_[row][v]) {
+            path.push_back(ids_[v]);
+        }
+        reverse(path.begin(), path.end());
+        return path;
+    }
+    if (meets_.empty() || !ch_) {
+        return path;
+    }
+
+    auto parentIn = [](const vector<pair<int, int>>& space, int v) {
+        return lower_bound(space.begin(), space.end(), make_pair(v, -1))->second;
+    };
+    // upward halves of the path in the hierarchy, which meet at the most important airport on it
+    int meet = meets_[cell];
+    vector<int> up;
+    for (int v = meet; v != -1; v = parentIn(forwardSpaces_[row], v)) { up.push_back(v); }
+    reverse(up.begin(), up.end());
+    for (int v = parentIn(backwardSpaces_[column], meet); v != -1; v = parentIn(backwardSpaces_[column], v)) {
+        up.push_back(v);
+    }
+
+    vector<int> indices(1, up[0]);
+    for (size_t i = 1; i < up.size(); i++) {
+        ch_->unpack(up[i - 1], up[i], indices);
+    }
+    for (int v : indices) { path.push_back(ch_->getID(v)); }
+    return path;
+}
+
+DistanceMatrix distanceMatrix(const Graph& g, const vector<int>& sources, const vector<int>& targets,
+    bool keepPaths, int threads) {
+    const CSRGraph& csr = g.csr();
+    DistanceMatrix matrix;
+    matrix.sources_ = sources;
+    matrix.targets_ = targets;
+    matrix.distances_.assign(sources.size() * targets.size(), numeric_limits<double>::infinity());
+    if (keepPaths) {
+        matrix.ids_ = csr.getIDs();
+        matrix.parents_.resize(sources.size());
+    }
+
+    vector<int> targetIndices;
+    for (int id : targets) { targetIndices.push_back(csr.getIndex(id)); }
+
+    // the rows are independent, so each source is searched on its own thread
+    vector<vector<double>> distances(threads <= 0 ? defaultThreads() : threads);
+    parallelFor(sources.size(), threads, [&](int row, int thread) {
+        int s = csr.getIndex(sources[row]);
+        if (s == -1) { return; }
+        shortestDistances(csr, s, false, distances[thread], keepPaths ? &matrix.parents_[row] : nullptr);
+        for (size_t column = 0; column < targets.size(); column++) {
+            if (targetIndices[column] != -1) {
+                matrix.distances_[row * targets.size() + column] = distances[thread][targetIndices[column]];
+            }
+        }
+    });
+    return matrix;
+}
+
+namespace {
+    /**
+    * @brief Per-thread state for searching upwards in a hierarchy
+    */
+    struct UpwardSearch {
+        vector<double> dist;
+        vector<int> parent;
+        vector<int> touched;
+        vector<pair<int, double>> settled; // the airports settled (and not stalled) with their distances
+
+        /**
+        * @brief Searches every airport reachable upwards from start
+        *
+        * @param ch The hierarchy
+        * @param start The starting airport's dense index
+        * @param forward Whether to follow upward connections (true) or downward connections backwards (false)
+        * @param space If given, filled with (airport, parent) for every settled airport, sorted by airport
+        */
+        void run(const ContractionHierarchy& ch, int start, bool forward, vector<pair<int, int>>* space) {
+            double inf = numeric_limits<double>::infinity();
+            if (dist.empty()) {
+                dist.assign(ch.size(), inf);
+                parent.assign(ch.size(), -1);
+            }
+            for (int v : touched) {
+                dist[v] = inf;
+                parent[v] = -1;
+            }
+            touched.clear();
+            settled.clear();
+
+            typedef pair<double, int> QueueNode;
+            priority_queue<QueueNode, vector<QueueNode>, greater<QueueNode>> qu;
+            dist[start] = 0;
+            touched.push_back(start);
+            qu.push(QueueNode(0, start));
+            while (!qu.empty()) {
+                QueueNode node = qu.top();
+                qu.pop();
+                int v = node.second;
+                if (node.first > dist[v]) { continue; }
+
+                // stall-on-demand, as in ContractionHierarchy's queries
+                bool stalled = false;
+                int begin = forward ? ch.downBegin(v) : ch.upBegin(v);
+                int end = forward ? ch.downEnd(v) : ch.upEnd(v);
+                for (int a = begin; a < end && !stalled; a++) {
+                    int other = forward ? ch.downSource(a) : ch.upTarget(a);
+                    stalled = dist[other] + (forward ? ch.downWeight(a) : ch.upWeight(a)) < node.first;
+                }
+                if (stalled) { continue; }
+                settled.push_back(make_pair(v, node.first));
+
+                begin = forward ? ch.upBegin(v) : ch.downBegin(v);
+                end = forward ? ch.upEnd(v) : ch.downEnd(v);
+                for (int a = begin; a < end; a++) {
+                    int other = forward ? ch.upTarget(a) : ch.downSource(a);
+                    double alt = node.first + (forward ? ch.upWeight(a) : ch.downWeight(a));
+                    if (alt < dist[other]) {
+                        if (dist[other] == inf) { touched.push_back(other); }
+                        dist[other] = alt;
+                        parent[other] = v;
+                        qu.push(QueueNode(alt, other));
+                    }
+                }
+            }
+
+            if (space) {
+                space->clear();
+                for (auto& node : settled) { space->push_back(make_pair(node.first, parent[node.first])); }
+                sort(space->begin(), space->end());
+            }
+        }
+    };
+
+    /**
+    * @brief A target's distance left at an airport by the target's backward search
+    */
+    struct BucketEntry {
+        int column;
+        double distance;
+    };
+}
+
+DistanceMatrix distanceMatrix(const ContractionHierarchy& ch, const vector<int>& sources, const vector<int>& targets,
+    bool keepPaths, int threads) {
+    if (threads <= 0) { threads = defaultThreads(); }
+    DistanceMatrix matrix;
+    matrix.sources_ = sources;
+    matrix.targets_ = targets;
+    matrix.distances_.assign(sources.size() * targets.size(), numeric_limits<double>::infinity());
+    matrix.meets_.assign(sources.size() * targets.size(), -1);
+    if (keepPaths) {
+        matrix.ch_ = &ch;
+        matrix.forwardSpaces_.resize(sources.size());
+        matrix.backwardSpaces_.resize(targets.size());
+    }
+
+    // backward searches from every target, in parallel
+    vector<UpwardSearch> searches(threads);
+    vector<vector<pair<int, double>>> targetSpaces(targets.size());
+    parallelFor(targets.size(), threads, [&](int column, int thread) {
+        int t = ch.getIndex(targets[column]);
+        if (t == -1) { return; }
+        searches[thread].run(ch, t, false, keepPaths ? &matrix.backwardSpaces_[column] : nullptr);
+        targetSpaces[column] = searches[thread].settled;
+    });
+
+    // fills the buckets, grouped by airport in CSR form
+    int n = ch.size();
+    vector<int> bucketOffsets(n + 1, 0);
+    for (auto& space : targetSpaces) {
+        for (auto& node : space) { bucketOffsets[node.first + 1]++; }
+    }
+    for (int v = 0; v < n; v++) { bucketOffsets[v + 1] += bucketOffsets[v]; }
+    vector<BucketEntry> buckets(bucketOffsets[n]);
+    vector<int> next(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for (size_t column = 0; column < targetSpaces.size(); column++) {
+        for (auto& node : targetSpaces[column]) {
+            buckets[next[node.first]++] = BucketEntry{(int)column, node.second};
+        }
+    }
+
+    // forward searches from every source scan the buckets they reach; each fills its own row
+    parallelFor(sources.size(), threads, [&](int row, int thread) {
+        int s = ch.getIndex(sources[row]);
+        if (s == -1) { return; }
+        UpwardSearch& search = searches[thread];
+        search.run(ch, s, true, keepPaths ? &matrix.forwardSpaces_[row] : nullptr);
+        double* distances = &matrix.distances_[(size_t)row * targets.size()];
+        int* meets = &matrix.meets_[(size_t)row * targets.size()];
+        for (auto& node : search.settled) {
+            for (int b = bucketOffsets[node.first]; b < bucketOffsets[node.first + 1]; b++) {
+                double alt = node.second + buckets[b].distance;
+                if (alt < distances[buckets[b].column]) {
+                    distances[buckets[b].column] = alt;
+                    meets[buckets[b].column] = node.first;
+                }
+            }
+        }
+    });
+    if (!keepPaths) {
+        matrix.meets_.clear();
+    }
+    return matrix;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+#include "contraction.h"
+
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+/**
+ * Class for a dense matrix of shortest distances between source and target airports
+ * Built by distanceMatrix(), which answers all pairs at once instead of one Dijkstra search per pair
+ */
+class DistanceMatrix {
+    public:
+        /**
+        * @brief Constructs an empty matrix
+        */
+        DistanceMatrix() : ch_(nullptr) {}
+
+        /**
+        * @brief Gets the number of sources (rows)
+        * @return The number of sources
+        */
+        int rows() const { return sources_.size(); }
+
+        /**
+        * @brief Gets the number of targets (columns)
+        * @return The number of targets
+        */
+        int columns() const { return targets_.size(); }
+
+        /**
+        * @brief Gets the source airport IDs, in row order
+        * @return The source IDs
+        */
+        const vector<int>& getSources() const { return sources_; }
+
+        /**
+        * @brief Gets the target airport IDs, in column order
+        * @return The target IDs
+        */
+        const vector<int>& getTargets() const { return targets_; }
+
+        /**
+        * @brief Gets the shortest distance between a source and a target
+        *
+        * @param row The source's position in the sources given
+        * @param column The target's position in the targets given
+        * @return The distance, or infinity if there is no path (or either airport is not in the graph)
+        */
+        double getDistance(int row, int column) const { return distances_[(size_t)row * targets_.size() + column]; }
+
+        /**
+        * @brief Gets the whole matrix, stored row by row
+        * @return The distances
+        */
+        const vector<double>& getDistances() const { return distances_; }
+
+        /**
+        * @brief Determines if paths were kept when the matrix was computed
+        * @return Whether getPath() can be used
+        */
+        bool hasPaths() const { return !parents_.empty() || !meets_.empty(); }
+
+        /**
+        * @brief Gets the shortest path between a source and a target (requires paths to have been kept)
+        *
+        * @param row The source's position in the sources given
+        * @param column The target's position in the targets given
+        * @return chronological vector of airport IDs from source to target (empty if there is no path)
+        */
+        vector<int> getPath(int row, int column) const;
+
+    private:
+        friend DistanceMatrix distanceMatrix(const Graph& g, const vector<int>& sources, const vector<int>& targets,
+            bool keepPaths, int threads);
+        friend DistanceMatrix distanceMatrix(const ContractionHierarchy& ch, const vector<int>& sources,
+            const vector<int>& targets, bool keepPaths, int threads);
+
+        vector<int> sources_, targets_; // the airport IDs of the rows and columns
+        vector<double> distances_; // the distances, row by row
+
+        // paths from one search per source: the IDs of the dense indices and each source's shortest path tree
+        vector<int> ids_;
+        vector<vector<int>> parents_;
+
+        // paths from the hierarchy: each search space as (airport, parent) sorted by airport, and the meeting points
+        const ContractionHierarchy* ch_;
+        vector<vector<pair<int, int>>> forwardSpaces_, backwardSpaces_;
+        vector<int> meets_;
+};
+
+/**
+* @brief Computes the shortest distances from every source to every target
+* Runs one Dijkstra search per source (rather than one per pair), spread over threads
+*
+* @param g The graph
+* @param sources The source airport IDs
+* @param targets The target airport IDs
+* @param keepPaths Whether to keep each source's shortest path tree so paths can be retrieved
+* @param threads How many threads to use (0 for all hardware threads)
+* @return DistanceMatrix The matrix of distances
+*/
+DistanceMatrix distanceMatrix(const Graph& g, const vector<int>& sources, const vector<int>& targets,
+    bool keepPaths = false, int threads = 0);
+
+/**
+* @brief Computes the shortest distances from every source to every target with bucket-based many-to-many
+* Each target's upward search in the hierarchy leaves its distance in a bucket at every airport it reaches.
+* Each source's upward search then scans the buckets it reaches, so the cost is one small search per
+* source and per target, plus the bucket scans
+*
+* @param ch The contraction hierarchy (must outlive the matrix if paths are kept)
+* @param sources The source airport IDs
+* @param targets The target airport IDs
+* @param keepPaths Whether to keep the search spaces so paths can be retrieved
+* @param threads How many threads to use (0 for all hardware threads)
+* @return DistanceMatrix The matrix of distances
+*/
+DistanceMatrix distanceMatrix(const ContractionHierarchy& ch, const vector<int>& sources, const vector<int>& targets,
+    bool keepPaths = false, int threads = 0);
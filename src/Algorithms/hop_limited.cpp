@@ -0,0 +1,92 @@
+#include "hop_limited.h"
+#include "../Parallel.h"
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+// airports handed to a thread at a time, so threads are not handed one airport per call
+static const int HOP_CHUNK = 512;
+
+bool HopLimitedPaths::build(const Graph& g, int source, int maxLegs, int threads) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    int s = csr.getIndex(source);
+    source_ = -1;
+    maxLegs_ = -1;
+    ids_.clear();
+    distances_.clear();
+    parents_.clear();
+    if (s == -1 || maxLegs < 0) { return false; }
+
+    source_ = source;
+    maxLegs_ = maxLegs;
+    ids_ = csr.getIDs();
+    distances_.assign((size_t)(maxLegs + 1) * n, numeric_limits<double>::infinity());
+    parents_.assign((size_t)(maxLegs + 1) * n, -1);
+    distances_[s] = 0;
+
+    // airports that improved in the previous layer; only they can improve anything in the next one
+    vector<char> improved(n, 0), nextImproved(n, 0);
+    improved[s] = 1;
+    bool stable = false;
+    int chunks = (n + HOP_CHUNK - 1) / HOP_CHUNK;
+    for (int k = 1; k <= maxLegs; k++) {
+        const double* previous = &distances_[(size_t)(k - 1) * n];
+        double* current = &distances_[(size_t)k * n];
+        int* parents = &parents_[(size_t)k * n];
+        if (stable) {
+            copy(previous, previous + n, current);
+            continue;
+        }
+        parallelFor(chunks, threads, [&](int chunk, int) {
+            int end = min(n, (chunk + 1) * HOP_CHUNK);
+            for (int v = chunk * HOP_CHUNK; v < end; v++) {
+                double best = previous[v];
+                int from = -1;
+                for (int i = csr.inBegin(v); i < csr.inEnd(v); i++) {
+                    int u = csr.source(i);
+                    if (!improved[u]) { continue; }
+                    double alt = previous[u] + csr.weight(csr.inEdge(i));
+                    if (alt < best) {
+                        best = alt;
+                        from = u;
+                    }
+                }
+                current[v] = best;
+                parents[v] = from;
+                nextImproved[v] = from != -1;
+            }
+        });
+        improved.swap(nextImproved);
+        stable = find(improved.begin(), improved.end(), 1) == improved.end();
+    }
+    return true;
+}
+
+int HopLimitedPaths::_index(int id) const {
+    auto it = lower_bound(ids_.begin(), ids_.end(), id);
+    return it == ids_.end() || *it != id ? -1 : it - ids_.begin();
+}
+
+double HopLimitedPaths::getDistance(int target, int legs) const {
+    int t = _index(target);
+    if (t == -1 || legs < 0 || legs > maxLegs_) { return numeric_limits<double>::infinity(); }
+    return distances_[(size_t)legs * ids_.size() + t];
+}
+
+vector<int> HopLimitedPaths::getPath(int target, int legs) const {
+    vector<int> path;
+    if (getDistance(target, legs) == numeric_limits<double>::infinity()) { return path; }
+    size_t n = ids_.size();
+    int v = _index(target);
+    // walks back through the layers: an airport that did not improve in a layer is reached as in the layer before
+    for (int k = legs; ; k--) {
+        while (k > 0 && parents_[k * n + v] == -1) { k--; }
+        path.push_back(ids_[v]);
+        if (k == 0) { break; }
+        v = parents_[k * n + v];
+    }
+    reverse(path.begin(), path.end());
+    return path;
+}
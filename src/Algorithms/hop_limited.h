@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Class for shortest paths with a limited number of legs (flights), from one origin to every airport
+ * Built by layered Bellman-Ford: layer k holds each airport's shortest distance using at most k legs,
+ * computed from layer k - 1 by relaxing every connection once. Each layer is split over threads by
+ * destination airport, so every thread only writes the airports it owns and the results do not depend
+ * on the number of threads. Only airports that improved in the previous layer are relaxed from, and once
+ * a layer improves nothing the remaining layers are copies of it.
+ *
+ * Ties go to the path with fewer legs
+ */
+class HopLimitedPaths {
+    public:
+        /**
+        * @brief Constructs an empty table (no distances until built)
+        */
+        HopLimitedPaths() : source_(-1), maxLegs_(-1) {}
+
+        /**
+        * @brief Computes the shortest distances with at most 0 to maxLegs legs from an origin to every airport
+        *
+        * @param g network of all airports
+        * @param source the origin airport ID
+        * @param maxLegs the most legs to allow
+        * @param threads How many threads to relax each layer on (0 for all hardware threads)
+        * @return bool Whether the table was built (false if the origin is not in the graph or maxLegs is negative)
+        */
+        bool build(const Graph& g, int source, int maxLegs, int threads = 0);
+
+        /**
+        * @brief Finds the shortest distance to an airport with at most a number of legs
+        *
+        * @param target the target airport ID
+        * @param legs the most legs to allow (at most the maxLegs built with)
+        * @return The distance, or infinity if there is no such path
+        */
+        double getDistance(int target, int legs) const;
+
+        /**
+        * @brief Generates the shortest path to an airport with at most a number of legs
+        *
+        * @param target the target airport ID
+        * @param legs the most legs to allow (at most the maxLegs built with)
+        * @return chronological vector of airport IDs from the origin to target (empty if there is no such path)
+        */
+        vector<int> getPath(int target, int legs) const;
+
+        /**
+        * @brief Gets the origin the table was built for
+        * @return The origin's ID (-1 if not built)
+        */
+        int getSource() const { return source_; }
+
+        /**
+        * @brief Gets the most legs the table was built for
+        * @return The number of legs (-1 if not built)
+        */
+        int maxLegs() const { return maxLegs_; }
+
+        /**
+        * @brief Gets the airport IDs, in the order of each layer in getDistances()
+        * @return The IDs, sorted
+        */
+        const vector<int>& getIDs() const { return ids_; }
+
+        /**
+        * @brief Gets every layer of distances, layer by layer (layer k starts at k * getIDs().size())
+        * @return The distances
+        */
+        const vector<double>& getDistances() const { return distances_; }
+
+    private:
+        /**
+        * @brief Finds an airport's position in each layer
+        *
+        * @param id The airport's ID
+        * @return int The position, or -1 if the airport is not in the table
+        */
+        int _index(int id) const;
+
+        int source_;
+        int maxLegs_;
+        vector<int> ids_; // the snapshot's airport IDs, so queries do not need the Graph
+        vector<double> distances_; // layer by layer
+        vector<int> parents_; // layer by layer, the previous airport if the airport improved in that layer (-1 if not)
+};
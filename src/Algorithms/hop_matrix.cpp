@@ -0,0 +1,193 @@
+#include "hop_matrix.h"
+#include "../Parallel.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static const char HOP_MATRIX_MAGIC[8] = {'H', 'O', 'P', 'M', 'A', 'T', 'R', '1'};
+
+namespace {
+    // 4 words of 64 bits: the sources of one batch
+    const int BATCH_WORDS = 4;
+    const int BATCH_SOURCES = BATCH_WORDS * 64;
+
+    /**
+    * @brief A set of a batch's sources
+    */
+    struct SourceSet {
+        uint64_t words[BATCH_WORDS];
+    };
+
+    /**
+    * @brief The start of a file written by HopMatrix::write()
+    */
+    struct HopMatrixHeader {
+        char magic[8];
+        uint64_t fingerprint; // fingerprint of the snapshot the matrix was computed for
+        int32_t size; // number of airports, followed by their IDs and then the rows
+        int32_t padding;
+    };
+
+    /**
+    * @brief A thread's bitsets for running batches
+    */
+    struct BatchState {
+        vector<SourceSet> seen, frontier, next;
+
+        /**
+        * @brief Searches from a batch of consecutive sources at once
+        *
+        * @param csr The snapshot
+        * @param first The first source's dense index
+        * @param count The number of sources (at most BATCH_SOURCES)
+        * @param rows Filled with the sources' rows
+        */
+        void run(const CSRGraph& csr, int first, int count, uint8_t* rows) {
+            int n = csr.size();
+            SourceSet empty = {};
+            seen.assign(n, empty);
+            frontier.assign(n, empty);
+            next.assign(n, empty);
+            fill(rows, rows + (size_t)count * n, HopMatrix::UNREACHABLE);
+            for (int i = 0; i < count; i++) {
+                int v = first + i;
+                seen[v].words[i / 64] |= uint64_t(1) << (i % 64);
+                frontier[v].words[i / 64] |= uint64_t(1) << (i % 64);
+                rows[(size_t)i * n + v] = 0;
+            }
+
+            for (int level = 1; ; level++) {
+                // every frontier airport passes its sources on to its neighbours
+                for (int v = 0; v < n; v++) {
+                    const SourceSet& from = frontier[v];
+                    if ((from.words[0] | from.words[1] | from.words[2] | from.words[3]) == 0) { continue; }
+                    for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+                        SourceSet& to = next[csr.target(e)];
+                        for (int k = 0; k < BATCH_WORDS; k++) { to.words[k] |= from.words[k]; }
+                    }
+                }
+                // sources arriving for the first time make the next frontier
+                uint8_t hops = min(level, (int)HopMatrix::UNREACHABLE - 1);
+                bool advanced = false;
+                for (int v = 0; v < n; v++) {
+                    for (int k = 0; k < BATCH_WORDS; k++) {
+                        uint64_t fresh = next[v].words[k] & ~seen[v].words[k];
+                        seen[v].words[k] |= fresh;
+                        frontier[v].words[k] = fresh;
+                        next[v].words[k] = 0;
+                        advanced |= fresh != 0;
+                        for (; fresh; fresh &= fresh - 1) {
+                            rows[(size_t)(k * 64 + __builtin_ctzll(fresh)) * n + v] = hops;
+                        }
+                    }
+                }
+                if (!advanced) { break; }
+            }
+        }
+    };
+}
+
+void HopMatrix::_run(const CSRGraph& csr, int threads, const function<void(int, int, const uint8_t*)>& sink) {
+    int n = csr.size();
+    if (threads <= 0) { threads = defaultThreads(); }
+    int batches = (n + BATCH_SOURCES - 1) / BATCH_SOURCES;
+    threads = max(1, min(threads, batches));
+    vector<BatchState> states(threads);
+    vector<vector<uint8_t>> rows(threads, vector<uint8_t>((size_t)BATCH_SOURCES * n));
+    // one batch per thread at a time, handed over in order before the next round
+    for (int round = 0; round < batches; round += threads) {
+        int count = min(threads, batches - round);
+        parallelFor(count, threads, [&](int i, int thread) {
+            int first = (round + i) * BATCH_SOURCES;
+            states[i].run(csr, first, min(BATCH_SOURCES, n - first), rows[i].data());
+        });
+        for (int i = 0; i < count; i++) {
+            int first = (round + i) * BATCH_SOURCES;
+            sink(first, min(BATCH_SOURCES, n - first), rows[i].data());
+        }
+    }
+}
+
+void HopMatrix::_count(HopStats& stats, const uint8_t* row, int source, int n, double& hopSum) {
+    int eccentricity = 0;
+    for (int v = 0; v < n; v++) {
+        if (row[v] == UNREACHABLE || v == source) { continue; }
+        eccentricity = max(eccentricity, (int)row[v]);
+        hopSum += row[v];
+        stats.connectedPairs++;
+    }
+    stats.eccentricities[source] = eccentricity;
+    stats.diameter = max(stats.diameter, eccentricity);
+    stats.averageHops = stats.connectedPairs > 0 ? hopSum / stats.connectedPairs : 0;
+}
+
+void HopMatrix::build(const Graph& g, int threads) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    ids_ = csr.getIDs();
+    matrix_.assign((size_t)n * n, UNREACHABLE);
+    stats_ = HopStats();
+    stats_.eccentricities.assign(n, 0);
+    double hopSum = 0;
+    _run(csr, threads, [&](int first, int count, const uint8_t* rows) {
+        copy(rows, rows + (size_t)count * n, matrix_.begin() + (size_t)first * n);
+        for (int i = 0; i < count; i++) { _count(stats_, rows + (size_t)i * n, first + i, n, hopSum); }
+    });
+}
+
+bool HopMatrix::write(const Graph& g, const string& filename, int threads, HopStats* stats) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    ofstream out(filename, ios::binary);
+    if (!out) { return false; }
+    HopMatrixHeader header;
+    memcpy(header.magic, HOP_MATRIX_MAGIC, sizeof(header.magic));
+    header.fingerprint = csr.fingerprint();
+    header.size = n;
+    header.padding = 0;
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)csr.getIDs().data(), (size_t)n * sizeof(int32_t));
+
+    HopStats counted;
+    counted.eccentricities.assign(n, 0);
+    double hopSum = 0;
+    _run(csr, threads, [&](int first, int count, const uint8_t* rows) {
+        out.write((const char*)rows, (size_t)count * n);
+        for (int i = 0; i < count; i++) { _count(counted, rows + (size_t)i * n, first + i, n, hopSum); }
+    });
+    if (stats) { *stats = counted; }
+    return (bool)out;
+}
+
+bool HopMatrix::load(const string& filename, const Graph& g) {
+    const CSRGraph& csr = g.csr();
+    ifstream in(filename, ios::binary);
+    HopMatrixHeader header;
+    if (!in.read((char*)&header, sizeof(header)) || memcmp(header.magic, HOP_MATRIX_MAGIC, sizeof(header.magic)) != 0
+        || header.fingerprint != csr.fingerprint() || header.size != csr.size()) {
+        return false;
+    }
+    int n = header.size;
+    vector<int> ids(n);
+    vector<uint8_t> matrix((size_t)n * n);
+    in.read((char*)ids.data(), (size_t)n * sizeof(int32_t));
+    in.read((char*)matrix.data(), matrix.size());
+    if (!in) { return false; }
+
+    ids_.swap(ids);
+    matrix_.swap(matrix);
+    stats_ = HopStats();
+    stats_.eccentricities.assign(n, 0);
+    double hopSum = 0;
+    for (int v = 0; v < n; v++) { _count(stats_, row(v), v, n, hopSum); }
+    return true;
+}
+
+uint8_t HopMatrix::getHops(int source, int target) const {
+    auto s = lower_bound(ids_.begin(), ids_.end(), source);
+    auto t = lower_bound(ids_.begin(), ids_.end(), target);
+    if (s == ids_.end() || *s != source || t == ids_.end() || *t != target) { return UNREACHABLE; }
+    return row(s - ids_.begin())[t - ids_.begin()];
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * @brief Hop-count analytics gathered while computing all-pairs hop distances
+ */
+struct HopStats {
+    int diameter = 0; // the most legs between any two airports connected at all
+    double averageHops = 0; // the average legs over every ordered pair of distinct connected airports
+    long long connectedPairs = 0; // the number of those pairs
+    vector<int> eccentricities; // by dense index, the most legs from the airport to any airport it reaches
+};
+
+/**
+ * Class for the all-pairs matrix of hop distances (fewest legs), one byte per pair
+ * Computed by bit-parallel multi-source BFS: 256 sources are searched at once, each airport holding a 256-bit
+ * set of the sources that have reached it, the sources in the frontier at it and those arriving next. A level
+ * ORs each frontier airport's set into its neighbours' arriving sets, so one pass over the connections advances
+ * all 256 searches. The bitsets are fixed arrays of words so the compiler can turn the word loops into SIMD
+ * instructions where the target has them. Batches of sources run in parallel.
+ *
+ * Rows are produced in source order, so the matrix can be written straight to a file without ever holding it
+ * in memory (see write()), and such a file can be loaded back
+ */
+class HopMatrix {
+    public:
+        // the entry for pairs with no path; distances of 254 legs or more are stored as 254
+        static constexpr uint8_t UNREACHABLE = 255;
+
+        /**
+        * @brief Computes the whole matrix in memory
+        *
+        * @param g network of all airports
+        * @param threads How many threads to run batches of sources on (0 for all hardware threads)
+        */
+        void build(const Graph& g, int threads = 0);
+
+        /**
+        * @brief Computes the matrix and writes it to a binary file row by row, without keeping it in memory
+        *
+        * @param g network of all airports
+        * @param filename The file to write
+        * @param threads How many threads to run batches of sources on (0 for all hardware threads)
+        * @param stats If given, filled with the hop analytics
+        * @return bool Whether the file was written
+        */
+        static bool write(const Graph& g, const string& filename, int threads = 0, HopStats* stats = nullptr);
+
+        /**
+        * @brief Reads a matrix written by write()
+        * The matrix is only accepted if it was computed for a graph with the same airports and connections
+        *
+        * @param filename The file to read
+        * @param g The graph the matrix should belong to
+        * @return bool Whether the matrix was loaded (if not, this is left unchanged)
+        */
+        bool load(const string& filename, const Graph& g);
+
+        /**
+        * @brief Gets the fewest legs from one airport to another
+        *
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @return uint8_t The legs, or UNREACHABLE if there is no path (or either airport is not in the matrix)
+        */
+        uint8_t getHops(int source, int target) const;
+
+        /**
+        * @brief Gets the row of a source, by dense index
+        *
+        * @param index The source's dense index
+        * @return const uint8_t* The legs to every airport, by dense index
+        */
+        const uint8_t* row(int index) const { return matrix_.data() + (size_t)index * ids_.size(); }
+
+        /**
+        * @brief Gets the number of airports (rows and columns)
+        * @return The number of airports
+        */
+        int size() const { return ids_.size(); }
+
+        /**
+        * @brief Gets the hop analytics of the matrix
+        * @return The analytics
+        */
+        const HopStats& getStats() const { return stats_; }
+
+    private:
+        /**
+        * @brief Runs every batch of sources and hands their rows over in source order
+        *
+        * @param csr The snapshot
+        * @param threads How many threads to use (0 for all hardware threads)
+        * @param sink Called with the first source's dense index, the number of sources and their rows, in order
+        */
+        static void _run(const CSRGraph& csr, int threads, const function<void(int, int, const uint8_t*)>& sink);
+
+        /**
+        * @brief Adds a row to the analytics
+        *
+        * @param stats The analytics
+        * @param row The row
+        * @param source The row's dense index
+        * @param n The number of airports
+        * @param hopSum The running sum of legs over connected pairs
+        */
+        static void _count(HopStats& stats, const uint8_t* row, int source, int n, double& hopSum);
+
+        vector<int> ids_; // the snapshot's airport IDs, in row and column order
+        vector<uint8_t> matrix_; // row by row
+        HopStats stats_;
+};
@@ -0,0 +1,325 @@
+#include "hub_labels.h"
+#include "../SearchWorkspace.h"
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <limits>
+#include <cstring>
+#include <tuple>
+
+using namespace std;
+
+static const char HUB_LABEL_MAGIC[8] = {'H', 'U', 'B', 'L', 'A', 'B', 'L', '1'};
+
+/**
+* @brief Rounds a byte count up to a multiple of 8
+*
+* @param bytes The byte count
+* @return size_t The rounded count
+*/
+static size_t aligned(size_t bytes) {
+    return (bytes + 7) / 8 * 8;
+}
+
+HubLabels::Layout HubLabels::_layout(size_t n, size_t outEntries, size_t inEntries) {
+    Layout layout;
+    layout.ids = aligned(sizeof(Header));
+    layout.hubs = aligned(layout.ids + n * sizeof(int32_t));
+    layout.outOffsets = aligned(layout.hubs + n * sizeof(int32_t));
+    layout.inOffsets = layout.outOffsets + (n + 1) * sizeof(uint64_t);
+    layout.outLabels = layout.inOffsets + (n + 1) * sizeof(uint64_t);
+    layout.inLabels = layout.outLabels + outEntries * sizeof(Entry);
+    layout.bytes = layout.inLabels + inEntries * sizeof(Entry);
+    return layout;
+}
+
+void HubLabels::build(const Graph& g) {
+    build(g, map<int, int>());
+}
+
+void HubLabels::build(const Graph& g, const map<int, int>& scores) {
+    const CSRGraph& csr = g.csr();
+    // sorts by highest score, then most connections, then ID
+    vector<tuple<int, int, int>> keys;
+    for (int v = 0; v < csr.size(); v++) {
+        auto it = scores.find(csr.getID(v));
+        int score = it == scores.end() ? 0 : it->second;
+        keys.push_back(make_tuple(-score, -(csr.outDegree(v) + csr.inDegree(v)), csr.getID(v)));
+    }
+    sort(keys.begin(), keys.end());
+    vector<int> order;
+    for (auto& key : keys) { order.push_back(get<2>(key)); }
+    build(g, order);
+}
+
+void HubLabels::build(const Graph& g, const vector<int>& order) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    vector<int> hubs;
+    vector<bool> placed(n, false);
+    for (int id : order) {
+        int v = csr.getIndex(id);
+        if (v != -1 && !placed[v]) {
+            hubs.push_back(v);
+            placed[v] = true;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (!placed[v]) { hubs.push_back(v); }
+    }
+
+    // labels are filled hub by hub, so each label is already sorted by hub rank
+    vector<vector<Entry>> out(n), in(n);
+    double inf = numeric_limits<double>::infinity();
+    vector<double> hubDistances(n, inf); // by rank, the current hub's own label, for pruning checks in O(label)
+    SearchWorkspace& ws = SearchWorkspace::local();
+
+    // searches from a hub, adding it to the label of every airport the existing labels do not already cover
+    auto prunedSearch = [&](int rank, bool forward) {
+        int h = hubs[rank];
+        const vector<Entry>& hubLabel = forward ? out[h] : in[h];
+        for (const Entry& e : hubLabel) { hubDistances[e.hub] = e.distance; }
+
+        ws.reset(n);
+        vector<pair<double, int>>& qu = ws.heap();
+        ws.reach(h, 0, -1);
+        qu.push_back(make_pair(0.0, h));
+        while (!qu.empty()) {
+            pair<double, int> node = qu.front();
+            pop_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+            qu.pop_back();
+            int v = node.second;
+            if (ws.visited(v)) { continue; }
+            ws.visit(v);
+
+            vector<Entry>& label = forward ? in[v] : out[v];
+            bool covered = false;
+            for (size_t i = 0; i < label.size() && !covered; i++) {
+                covered = hubDistances[label[i].hub] + label[i].distance <= node.first;
+            }
+            // covered airports are not searched past: anything beyond them is covered through the same hub
+            if (covered) { continue; }
+            label.push_back(Entry{rank, ws.parent(v), node.first});
+
+            int begin = forward ? csr.outBegin(v) : csr.inBegin(v);
+            int end = forward ? csr.outEnd(v) : csr.inEnd(v);
+            for (int a = begin; a < end; a++) {
+                int other = forward ? csr.target(a) : csr.source(a);
+                double alt = node.first + csr.weight(forward ? a : csr.inEdge(a));
+                if (alt < ws.distance(other)) {
+                    ws.reach(other, alt, v);
+                    qu.push_back(make_pair(alt, other));
+                    push_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+                }
+            }
+        }
+        for (const Entry& e : hubLabel) { hubDistances[e.hub] = inf; }
+    };
+    for (int rank = 0; rank < n; rank++) {
+        prunedSearch(rank, true);
+        prunedSearch(rank, false);
+    }
+
+    // flattens the labels into the buffer
+    size_t outEntries = 0, inEntries = 0;
+    for (int v = 0; v < n; v++) {
+        outEntries += out[v].size();
+        inEntries += in[v].size();
+    }
+    Layout layout = _layout(n, outEntries, inEntries);
+    vector<uint64_t> buffer(layout.bytes / 8, 0);
+    char* data = (char*)buffer.data();
+    Header header;
+    memcpy(header.magic, HUB_LABEL_MAGIC, sizeof(header.magic));
+    header.fingerprint = csr.fingerprint();
+    header.bytes = layout.bytes;
+    header.outEntries = outEntries;
+    header.inEntries = inEntries;
+    header.size = n;
+    header.padding = 0;
+    memcpy(data, &header, sizeof(header));
+    memcpy(data + layout.ids, csr.getIDs().data(), n * sizeof(int32_t));
+    memcpy(data + layout.hubs, hubs.data(), n * sizeof(int32_t));
+    uint64_t* outOffsets = (uint64_t*)(data + layout.outOffsets);
+    uint64_t* inOffsets = (uint64_t*)(data + layout.inOffsets);
+    Entry* outLabels = (Entry*)(data + layout.outLabels);
+    Entry* inLabels = (Entry*)(data + layout.inLabels);
+    outOffsets[0] = inOffsets[0] = 0;
+    for (int v = 0; v < n; v++) {
+        copy(out[v].begin(), out[v].end(), outLabels + outOffsets[v]);
+        copy(in[v].begin(), in[v].end(), inLabels + inOffsets[v]);
+        outOffsets[v + 1] = outOffsets[v] + out[v].size();
+        inOffsets[v + 1] = inOffsets[v] + in[v].size();
+    }
+
+    buffer_.swap(buffer);
+    external_ = nullptr;
+    layout_ = layout;
+}
+
+double HubLabels::_query(int s, int t, int& hub) const {
+    const uint64_t* outOffsets = _array<uint64_t>(layout_.outOffsets);
+    const uint64_t* inOffsets = _array<uint64_t>(layout_.inOffsets);
+    const Entry* a = _array<Entry>(layout_.outLabels) + outOffsets[s];
+    const Entry* aEnd = _array<Entry>(layout_.outLabels) + outOffsets[s + 1];
+    const Entry* b = _array<Entry>(layout_.inLabels) + inOffsets[t];
+    const Entry* bEnd = _array<Entry>(layout_.inLabels) + inOffsets[t + 1];
+
+    // merges the two labels, which are both sorted by hub rank
+    double best = numeric_limits<double>::infinity();
+    hub = -1;
+    while (a != aEnd && b != bEnd) {
+        if (a->hub < b->hub) {
+            a++;
+        } else if (b->hub < a->hub) {
+            b++;
+        } else {
+            if (a->distance + b->distance < best) {
+                best = a->distance + b->distance;
+                hub = a->hub;
+            }
+            a++;
+            b++;
+        }
+    }
+    return best;
+}
+
+const HubLabels::Entry* HubLabels::_find(const Entry* label, const Entry* end, int hub) {
+    const Entry* found = lower_bound(label, end, hub, [](const Entry& e, int rank) { return e.hub < rank; });
+    return found != end && found->hub == hub ? found : nullptr;
+}
+
+double HubLabels::getDistance(int source, int target) const {
+    if (!_data()) { return numeric_limits<double>::infinity(); }
+    const int32_t* ids = _array<int32_t>(layout_.ids);
+    int n = size();
+    const int32_t* s = lower_bound(ids, ids + n, source);
+    const int32_t* t = lower_bound(ids, ids + n, target);
+    if (s == ids + n || *s != source || t == ids + n || *t != target) {
+        return numeric_limits<double>::infinity();
+    }
+    int hub;
+    return _query(s - ids, t - ids, hub);
+}
+
+vector<int> HubLabels::getPath(int source, int target) const {
+    vector<int> path;
+    if (!_data()) { return path; }
+    const int32_t* ids = _array<int32_t>(layout_.ids);
+    int n = size();
+    const int32_t* sourceIt = lower_bound(ids, ids + n, source);
+    const int32_t* targetIt = lower_bound(ids, ids + n, target);
+    if (sourceIt == ids + n || *sourceIt != source || targetIt == ids + n || *targetIt != target) {
+        return path;
+    }
+    int s = sourceIt - ids, t = targetIt - ids;
+    int rank;
+    if (_query(s, t, rank) == numeric_limits<double>::infinity()) {
+        return path;
+    }
+
+    // every airport on a labeled shortest path to or from a hub has the hub in its label too,
+    // so the parents lead from the source up to the hub and from the target back to it
+    int hub = _array<int32_t>(layout_.hubs)[rank];
+    const uint64_t* outOffsets = _array<uint64_t>(layout_.outOffsets);
+    const uint64_t* inOffsets = _array<uint64_t>(layout_.inOffsets);
+    const Entry* outLabels = _array<Entry>(layout_.outLabels);
+    const Entry* inLabels = _array<Entry>(layout_.inLabels);
+    // a chain that leaves the hub's labels or goes on longer than every airport only comes from labels that were
+    // not built by build(), so no path is given
+    for (int v = s; v != hub; ) {
+        const Entry* entry = _find(outLabels + outOffsets[v], outLabels + outOffsets[v + 1], rank);
+        if (!entry || entry->parent == -1 || (int)path.size() == n) { return vector<int>(); }
+        path.push_back(ids[v]);
+        v = entry->parent;
+    }
+    vector<int> back;
+    for (int v = t; v != hub; ) {
+        const Entry* entry = _find(inLabels + inOffsets[v], inLabels + inOffsets[v + 1], rank);
+        if (!entry || entry->parent == -1 || (int)back.size() == n) { return vector<int>(); }
+        back.push_back(ids[v]);
+        v = entry->parent;
+    }
+    path.push_back(ids[hub]);
+    path.insert(path.end(), back.rbegin(), back.rend());
+    return path;
+}
+
+bool HubLabels::_valid(const char* data, size_t bytes, const CSRGraph& csr) {
+    if (bytes < sizeof(Header)) { return false; }
+    const Header& header = *(const Header*)data;
+    // the entry counts are bounded first, so the layout cannot overflow into a size that happens to match
+    if (memcmp(header.magic, HUB_LABEL_MAGIC, sizeof(header.magic)) != 0 || header.bytes != bytes
+        || header.fingerprint != csr.fingerprint() || header.size != csr.size()
+        || header.outEntries > bytes / sizeof(Entry) || header.inEntries > bytes / sizeof(Entry)) {
+        return false;
+    }
+    size_t n = header.size;
+    Layout layout = _layout(n, header.outEntries, header.inEntries);
+    if (layout.bytes != bytes
+        || memcmp(data + layout.ids, csr.getIDs().data(), n * sizeof(int32_t)) != 0) {
+        return false;
+    }
+
+    // queries index by every offset, hub and parent without checking, so they are all checked here
+    const int32_t* hubs = (const int32_t*)(data + layout.hubs);
+    for (size_t rank = 0; rank < n; rank++) {
+        if (hubs[rank] < 0 || hubs[rank] >= (int32_t)n) { return false; }
+    }
+    auto validLabels = [&](const uint64_t* offsets, const Entry* labels, uint64_t entries) {
+        if (offsets[0] != 0 || offsets[n] != entries) { return false; }
+        for (size_t v = 0; v < n; v++) {
+            if (offsets[v + 1] < offsets[v] || offsets[v + 1] > entries) { return false; }
+            // each label is sorted by hub rank, as the merge and the binary search need
+            for (uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+                const Entry& e = labels[i];
+                if (e.hub < 0 || e.hub >= (int32_t)n || e.parent < -1 || e.parent >= (int32_t)n
+                    || (i > offsets[v] && labels[i - 1].hub >= e.hub)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    return validLabels((const uint64_t*)(data + layout.outOffsets), (const Entry*)(data + layout.outLabels),
+        header.outEntries)
+        && validLabels((const uint64_t*)(data + layout.inOffsets), (const Entry*)(data + layout.inLabels),
+        header.inEntries);
+}
+
+bool HubLabels::save(const string& filename) const {
+    if (!_data()) { return false; }
+    ofstream out(filename, ios::binary);
+    if (!out) { return false; }
+    out.write(_data(), bytes());
+    return (bool)out;
+}
+
+bool HubLabels::load(const string& filename, const Graph& g) {
+    ifstream in(filename, ios::binary | ios::ate);
+    if (!in) { return false; }
+    size_t bytes = in.tellg();
+    in.seekg(0);
+    vector<uint64_t> buffer(aligned(bytes) / 8);
+    in.read((char*)buffer.data(), bytes);
+    if (!in || !_valid((const char*)buffer.data(), bytes, g.csr())) {
+        return false;
+    }
+    const Header& header = *(const Header*)buffer.data();
+    layout_ = _layout(header.size, header.outEntries, header.inEntries);
+    buffer_.swap(buffer);
+    external_ = nullptr;
+    return true;
+}
+
+bool HubLabels::attach(const void* data, size_t bytes, const Graph& g) {
+    if ((uintptr_t)data % 8 != 0 || !_valid((const char*)data, bytes, g.csr())) {
+        return false;
+    }
+    const Header& header = *(const Header*)data;
+    layout_ = _layout(header.size, header.outEntries, header.inEntries);
+    buffer_.clear();
+    external_ = (const char*)data;
+    return true;
+}
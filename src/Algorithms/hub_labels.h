@@ -0,0 +1,208 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Class for a 2-hop hub labeling distance oracle
+ * Every airport gets a forward label (hubs it can reach, with distances) and a backward label
+ * (hubs that reach it). The shortest distance from s to t is the best sum over the hubs common to
+ * s's forward label and t's backward label, found by merging the two sorted labels.
+ * Labels are built by pruned landmark labeling: one pruned Dijkstra search per airport, most
+ * important (hub) airports first, skipping every airport whose distance the labels already cover.
+ *
+ * The labels are kept in a single flat buffer that is written to and read from files as is, so a
+ * file can also be mapped into memory and used in place with attach()
+ */
+class HubLabels {
+    public:
+        /**
+        * @brief Constructs an empty oracle (no distances until built, loaded or attached)
+        */
+        HubLabels() : external_(nullptr) {}
+
+        /**
+        * @brief Builds the labels, ordering airports by their number of connections
+        *
+        * @param g The graph to preprocess
+        */
+        void build(const Graph& g);
+
+        /**
+        * @brief Builds the labels, ordering airports by scores such as BetweenessCentrality's
+        * Airports with higher scores become hubs first; ties (and airports without a score) are
+        * ordered by their number of connections
+        *
+        * @param g The graph to preprocess
+        * @param scores Maps airport IDs to scores
+        */
+        void build(const Graph& g, const map<int, int>& scores);
+
+        /**
+        * @brief Builds the labels with a given hub order
+        *
+        * @param g The graph to preprocess
+        * @param order Airport IDs from most to least important (airports left out are added last)
+        */
+        void build(const Graph& g, const vector<int>& order);
+
+        /**
+        * @brief Finds the shortest distance between two airports
+        *
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @return The distance between the airports, or infinity if there is no path
+        */
+        double getDistance(int source, int target) const;
+
+        /**
+        * @brief Generates the shortest path of airports from source to target
+        *
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @return chronological vector of airport IDs from source to target (empty if there is no path)
+        */
+        vector<int> getPath(int source, int target) const;
+
+        /**
+        * @brief Writes the labels to a binary file
+        *
+        * @param filename The file to write
+        * @return bool Whether the file was written
+        */
+        bool save(const string& filename) const;
+
+        /**
+        * @brief Reads labels written by save()
+        * The labels are only accepted if they were built for a graph with the same airports and connections
+        *
+        * @param filename The file to read
+        * @param g The graph the labels should belong to
+        * @return bool Whether the labels were loaded (if not, this is left unchanged)
+        */
+        bool load(const string& filename, const Graph& g);
+
+        /**
+        * @brief Uses labels written by save() from memory without copying them, such as a mapped file
+        * The labels are checked the same way as load() checks a file, which reads them once
+        *
+        * @param data The file's contents (must be 8-byte aligned and outlive this oracle)
+        * @param bytes The size of the file
+        * @param g The graph the labels should belong to
+        * @return bool Whether the labels were accepted (if not, this is left unchanged)
+        */
+        bool attach(const void* data, size_t bytes, const Graph& g);
+
+        /**
+        * @brief Determines if the labels were built for a snapshot
+        *
+        * @param csr The snapshot to check
+        * @return bool Whether the labels match the snapshot
+        */
+        bool matches(const CSRGraph& csr) const { return _data() && _header().fingerprint == csr.fingerprint(); }
+
+        /**
+        * @brief Gets the number of airports labeled
+        * @return The number of airports
+        */
+        int size() const { return _data() ? _header().size : 0; }
+
+        /**
+        * @brief Gets the total number of entries in every forward and backward label
+        * @return The number of entries
+        */
+        size_t labelEntries() const { return _data() ? _header().outEntries + _header().inEntries : 0; }
+
+        /**
+        * @brief Gets the size of the flat buffer (and of the file written by save())
+        * @return The number of bytes
+        */
+        size_t bytes() const { return _data() ? _header().bytes : 0; }
+
+    private:
+        /**
+        * @brief The start of the flat buffer
+        */
+        struct Header {
+            char magic[8];
+            uint64_t fingerprint; // fingerprint of the snapshot the labels were built for
+            uint64_t bytes; // size of the whole buffer
+            uint64_t outEntries, inEntries; // number of forward and backward label entries
+            int32_t size; // number of airports
+            int32_t padding;
+        };
+
+        /**
+        * @brief One hub in a label
+        */
+        struct Entry {
+            int32_t hub; // the hub's rank (its position in the hub order)
+            int32_t parent; // dense index of the next airport towards the hub (-1 at the hub)
+            double distance; // distance to (forward) or from (backward) the hub
+        };
+
+        /**
+        * @brief Where each array starts in the flat buffer, in bytes
+        */
+        struct Layout {
+            size_t ids, hubs, outOffsets, inOffsets, outLabels, inLabels, bytes;
+        };
+
+        /**
+        * @brief Computes where each array goes in a buffer, keeping each 8-byte aligned
+        *
+        * @param n The number of airports
+        * @param outEntries The number of forward label entries
+        * @param inEntries The number of backward label entries
+        * @return Layout The array positions
+        */
+        static Layout _layout(size_t n, size_t outEntries, size_t inEntries);
+
+        /**
+        * @brief Checks that a buffer holds labels for a graph, with every offset, hub and parent in range
+        *
+        * @param data The buffer
+        * @param bytes The size of the buffer
+        * @param csr The snapshot the labels should belong to
+        * @return bool Whether the buffer is valid
+        */
+        static bool _valid(const char* data, size_t bytes, const CSRGraph& csr);
+
+        /**
+        * @brief Finds the best hub common to a source's forward label and a target's backward label
+        *
+        * @param s The source's dense index
+        * @param t The target's dense index
+        * @param hub Set to the best hub's rank (-1 if there is none)
+        * @return double The shortest distance
+        */
+        double _query(int s, int t, int& hub) const;
+
+        /**
+        * @brief Finds a hub's entry in a label by binary search
+        *
+        * @param label The first entry of the label
+        * @param end One past the last entry of the label
+        * @param hub The hub's rank
+        * @return const Entry* The entry (nullptr if the hub is not in the label)
+        */
+        static const Entry* _find(const Entry* label, const Entry* end, int hub);
+
+        // the buffer in use (owned or attached, nullptr if there are no labels), its header and its arrays
+        const char* _data() const { return external_ ? external_ : buffer_.empty() ? nullptr : (const char*)buffer_.data(); }
+        const Header& _header() const { return *(const Header*)_data(); }
+        template <typename T>
+        const T* _array(size_t position) const { return (const T*)(_data() + position); }
+
+        vector<uint64_t> buffer_; // the labels when owned (uint64_t keeps it 8-byte aligned)
+        const char* external_; // the labels when attached
+        Layout layout_; // where the arrays are in the buffer
+};
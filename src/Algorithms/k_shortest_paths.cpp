@@ -0,0 +1,159 @@
+#include "k_shortest_paths.h"
+#include "shortest_paths.h"
+#include "../SearchWorkspace.h"
+#include "../Parallel.h"
+#include <set>
+#include <limits>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+double KShortestPaths::_spurPath(const CSRGraph& csr, int spur, int t, const SearchMask& mask, vector<int>& path,
+    bool& searched) {
+    double inf = numeric_limits<double>::infinity();
+    path.clear();
+    searched = false;
+    if (toTarget_[spur] == inf) { return inf; }
+
+    // the tree's path is the shortest possible, so it is the answer whenever no ban touches it
+    bool treeUsable = true;
+    for (int v = spur; v != t && treeUsable; v = next_[v]) {
+        treeUsable = !mask.edgeBanned(csr.findEdge(v, next_[v])) && !mask.nodeBanned(next_[v]);
+    }
+    if (treeUsable) {
+        for (int v = spur; v != -1; v = next_[v]) { path.push_back(v); }
+        return toTarget_[spur];
+    }
+
+    // otherwise A*, with the tree's distances as the heuristic: bans only make paths longer, so they stay admissible
+    searched = true;
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.reset(csr.size());
+    vector<pair<double, int>>& qu = ws.heap();
+    ws.reach(spur, 0, -1);
+    qu.push_back(make_pair(toTarget_[spur], spur));
+    while (!qu.empty()) {
+        int v = qu.front().second;
+        pop_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+        qu.pop_back();
+        if (ws.visited(v)) { continue; }
+        ws.visit(v);
+        if (v == t) { break; }
+        for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+            int adj = csr.target(e);
+            // airports the query's mask bans are already out of the tree, but its banned connections are not
+            if (mask.edgeBanned(e) || mask.nodeBanned(adj) || toTarget_[adj] == inf || (avoid_ && avoid_->edgeBanned(e))) {
+                continue;
+            }
+            double alt = ws.distance(v) + csr.weight(e);
+            if (alt < ws.distance(adj)) {
+                ws.reach(adj, alt, v);
+                qu.push_back(make_pair(alt + toTarget_[adj], adj));
+                push_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+            }
+        }
+    }
+    if (!ws.visited(t)) { return inf; }
+    for (int v = t; v != -1; v = ws.parent(v)) { path.push_back(v); }
+    reverse(path.begin(), path.end());
+    return ws.distance(t);
+}
+
+namespace {
+    /**
+    * @brief A path found by the algorithm, in dense indices
+    */
+    struct CandidatePath {
+        double distance;
+        vector<int> nodes;
+        size_t deviation; // where it left the path it was spurred from; earlier spurs would only find known paths
+
+        bool operator<(const CandidatePath& other) const {
+            return distance < other.distance || (distance == other.distance && nodes < other.nodes);
+        }
+    };
+}
+
+vector<vector<int>> KShortestPaths::getPaths(const Graph& g, int source, int target, int k, int threads,
+    const SearchMask* mask) {
+    distances_.clear();
+    searches_ = 0;
+    avoid_ = mask;
+    vector<vector<int>> paths;
+    const CSRGraph& csr = g.csr();
+    int s = csr.getIndex(source);
+    int t = csr.getIndex(target);
+    if (s == -1 || t == -1 || k <= 0 || !csr.mayReach(s, t)) { return paths; }
+
+    // one tree towards the target, shared by every spur search
+    shortestDistances(csr, t, true, toTarget_, &next_, mask);
+    if (toTarget_[s] == numeric_limits<double>::infinity()) { return paths; }
+    if (threads <= 0) { threads = defaultThreads(); }
+    masks_.resize(threads);
+
+    vector<CandidatePath> found;
+    CandidatePath first;
+    first.distance = toTarget_[s];
+    first.deviation = 0;
+    for (int v = s; v != -1; v = next_[v]) { first.nodes.push_back(v); }
+    found.push_back(first);
+    set<CandidatePath> candidates;
+    set<vector<int>> known; // every path found or waiting as a candidate
+    known.insert(first.nodes);
+
+    while ((int)found.size() < k) {
+        const CandidatePath& last = found.back();
+        vector<double> prefix(last.nodes.size(), 0); // distance from the source to each airport on the path
+        for (size_t i = 1; i < last.nodes.size(); i++) {
+            prefix[i] = prefix[i - 1] + csr.weight(csr.findEdge(last.nodes[i - 1], last.nodes[i]));
+        }
+
+        // each airport on the last path (from where it deviated) is a spur, searched independently
+        size_t spurs = last.nodes.size() - 1 - last.deviation;
+        vector<CandidatePath> spurred(spurs);
+        atomic<int> searches(0);
+        parallelFor(spurs, threads, [&](int index, int thread) {
+            size_t i = last.deviation + index;
+            SearchMask& spurMask = masks_[thread];
+            spurMask.clear(csr);
+            // the path up to the spur is fixed, so its airports are banned to keep the result loopless
+            for (size_t j = 0; j < i; j++) { spurMask.banNode(last.nodes[j]); }
+            // connections that would recreate a known path with the same start are banned
+            for (const CandidatePath& path : found) {
+                if (path.nodes.size() > i + 1 && equal(path.nodes.begin(), path.nodes.begin() + i + 1, last.nodes.begin())) {
+                    spurMask.banEdge(csr.findEdge(path.nodes[i], path.nodes[i + 1]));
+                }
+            }
+            vector<int> spur;
+            bool searched;
+            double distance = _spurPath(csr, last.nodes[i], t, spurMask, spur, searched);
+            searches += searched;
+            if (spur.empty()) { return; }
+            CandidatePath& candidate = spurred[index];
+            candidate.distance = prefix[i] + distance;
+            candidate.nodes.assign(last.nodes.begin(), last.nodes.begin() + i);
+            candidate.nodes.insert(candidate.nodes.end(), spur.begin(), spur.end());
+            candidate.deviation = i;
+        });
+        searches_ += searches;
+
+        for (CandidatePath& candidate : spurred) {
+            if (!candidate.nodes.empty() && known.insert(candidate.nodes).second) {
+                candidates.insert(std::move(candidate));
+            }
+        }
+        if (candidates.empty()) { break; }
+        found.push_back(*candidates.begin());
+        candidates.erase(candidates.begin());
+    }
+
+    for (const CandidatePath& path : found) {
+        vector<int> ids;
+        for (int v : path.nodes) { ids.push_back(csr.getID(v)); }
+        paths.push_back(ids);
+        distances_.push_back(path.distance);
+    }
+    return paths;
+}
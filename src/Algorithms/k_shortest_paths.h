@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+#include "../SearchMask.h"
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Class for Yen's k shortest loopless paths
+ * Generates alternative itineraries between two airports in increasing order of distance.
+ * Each new path deviates from an earlier one at a spur airport: the airports before it are banned,
+ * as are the connections out of it already used by paths sharing the same start, and the shortest
+ * path from the spur airport to the target is searched for on what is left of the graph.
+ *
+ * One shortest path tree towards the target is built per query and reused by every spur search:
+ * its distances guide the spur searches as an exact A* heuristic, and whenever the tree's own path
+ * from the spur airport avoids every ban it is used without searching at all. Bans are SearchMasks,
+ * so the Graph is never copied, and the spur searches of each round run in parallel. A query can
+ * also be given its own mask of airports and connections to avoid, applied on top of the spur bans
+ */
+class KShortestPaths {
+    public:
+        /**
+        * @brief Generates up to k shortest loopless paths from source to target
+        *
+        * @param g network of all airports
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @param k the most paths to generate
+        * @param threads How many threads to run spur searches on (0 for all hardware threads)
+        * @param mask airports and connections no path may use, cleared for g's snapshot (nullptr to use them all)
+        * @return vector of chronological vectors of airport IDs from source to target, shortest first
+        * (fewer than k if there are no more paths, and empty if there is none)
+        */
+        vector<vector<int>> getPaths(const Graph& g, int source, int target, int k, int threads = 0,
+            const SearchMask* mask = nullptr);
+
+        /**
+        * @brief distances of the paths the last query generated
+        * @return The distance of each path, in the same order as the paths
+        */
+        const vector<double>& getDistances() const { return distances_; }
+
+        /**
+        * @brief number of spur searches the last query needed (spurs answered by the tree are not counted)
+        * @return The number of searches
+        */
+        int searchCount() const { return searches_; }
+
+    private:
+        /**
+        * @brief Finds the shortest path from a spur airport to the target that avoids a mask's bans
+        *
+        * @param csr The snapshot to search
+        * @param spur The spur airport's dense index
+        * @param t The target's dense index
+        * @param mask The spur's bans (the query's own mask is already applied by the tree)
+        * @param path Filled with the dense indices from the spur airport to the target (empty if there is none)
+        * @param searched Set to whether a search was needed (false if the tree's path was used)
+        * @return double The path's distance
+        */
+        double _spurPath(const CSRGraph& csr, int spur, int t, const SearchMask& mask, vector<int>& path, bool& searched);
+
+        const SearchMask* avoid_ = nullptr; // the last query's mask
+        vector<double> toTarget_; // each airport's distance to the target in the graph minus the query's mask
+        vector<int> next_; // each airport's next airport on its shortest path to the target
+        vector<SearchMask> masks_; // one per thread
+        vector<double> distances_; // distances of the last query's paths
+        int searches_ = 0;
+};
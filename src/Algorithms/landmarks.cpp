@@ -0,0 +1,258 @@
+#include "landmarks.h"
+#include "shortest_paths.h"
+#include "../Parallel.h"
+#include <fstream>
+#include <limits>
+#include <random>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static const char LANDMARK_MAGIC[8] = {'A', 'L', 'T', 'T', 'A', 'B', 'L', '1'};
+
+void Landmarks::build(const Graph& g, int count, Selection selection, int threads, unsigned seed) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    double inf = numeric_limits<double>::infinity();
+    fingerprint_ = csr.fingerprint();
+    size_ = n;
+    landmarks_.clear();
+    landmarkIDs_.clear();
+    from_.clear();
+    to_.clear();
+
+    // only airports with connections are worth using as landmarks
+    vector<int> candidates;
+    int busiest = -1;
+    for (int v = 0; v < n; v++) {
+        int degree = csr.outDegree(v) + csr.inDegree(v);
+        if (degree == 0) { continue; }
+        candidates.push_back(v);
+        if (busiest == -1 || degree > csr.outDegree(busiest) + csr.inDegree(busiest)) {
+            busiest = v;
+        }
+    }
+    if (candidates.empty() || count <= 0) { return; }
+    count = min(count, (int)candidates.size());
+
+    // the first landmark is the airport farthest from the busiest airport, for both selections
+    vector<double> distances;
+    shortestDistances(csr, busiest, false, distances);
+    int first = busiest;
+    for (int v : candidates) {
+        if (distances[v] < inf && distances[v] > distances[first]) { first = v; }
+    }
+
+    vector<vector<double>> forward; // the distances from each landmark chosen so far
+    vector<bool> isLandmark(n, false);
+    auto addLandmark = [&](int landmark) {
+        landmarks_.push_back(landmark);
+        isLandmark[landmark] = true;
+        forward.push_back(vector<double>());
+        shortestDistances(csr, landmark, false, forward.back());
+    };
+    addLandmark(first);
+
+    if (selection == FARTHEST) {
+        // the distance from each airport to its closest landmark
+        vector<double> closest = forward[0];
+        while ((int)landmarks_.size() < count) {
+            int next = -1;
+            for (int v : candidates) {
+                // airports no landmark reaches are not covered by this selection
+                if (isLandmark[v] || closest[v] == inf) { continue; }
+                if (next == -1 || closest[v] > closest[next]) { next = v; }
+            }
+            if (next == -1) { break; }
+            addLandmark(next);
+            for (int v = 0; v < n; v++) {
+                closest[v] = min(closest[v], forward.back()[v]);
+            }
+        }
+    } else {
+        mt19937 generator(seed);
+        uniform_int_distribution<int> pick(0, candidates.size() - 1);
+        vector<int> parents, childOffsets(n + 1), children(n), order(n);
+        vector<double> size(n);
+        vector<bool> covered(n);
+        int failures = 0;
+        while ((int)landmarks_.size() < count && failures < 4 * count) {
+            int root = candidates[pick(generator)];
+            shortestDistances(csr, root, false, distances, &parents);
+
+            // group each airport's children in the shortest path tree
+            fill(childOffsets.begin(), childOffsets.end(), 0);
+            for (int v = 0; v < n; v++) {
+                if (parents[v] != -1) { childOffsets[parents[v] + 1]++; }
+            }
+            for (int v = 0; v < n; v++) { childOffsets[v + 1] += childOffsets[v]; }
+            vector<int> next(childOffsets.begin(), childOffsets.end() - 1);
+            for (int v = 0; v < n; v++) {
+                if (parents[v] != -1) { children[next[parents[v]]++] = v; }
+            }
+
+            // a vertex's size is how badly the current bounds cover its subtree,
+            // and is zero if its subtree already contains a landmark
+            for (int v = 0; v < n; v++) { order[v] = v; }
+            sort(order.begin(), order.end(), [&](int a, int b) { return distances[a] > distances[b]; });
+            for (int v : order) {
+                if (distances[v] == inf) { size[v] = 0; covered[v] = false; continue; }
+                double bound = 0;
+                for (auto& table : forward) {
+                    if (table[root] < inf) { bound = max(bound, table[v] - table[root]); }
+                }
+                size[v] = distances[v] - min(bound, distances[v]);
+                covered[v] = isLandmark[v];
+                for (int c = childOffsets[v]; c < childOffsets[v + 1]; c++) {
+                    size[v] += size[children[c]];
+                    covered[v] = covered[v] || covered[children[c]];
+                }
+            }
+            for (int v = 0; v < n; v++) {
+                if (covered[v]) { size[v] = 0; }
+            }
+
+            // walks down the largest subtrees to a leaf, which becomes the next landmark
+            int leaf = root;
+            while (true) {
+                int best = -1;
+                for (int c = childOffsets[leaf]; c < childOffsets[leaf + 1]; c++) {
+                    if (best == -1 || size[children[c]] > size[best]) { best = children[c]; }
+                }
+                if (best == -1 || size[best] <= 0) { break; }
+                leaf = best;
+            }
+            if (leaf == root || isLandmark[leaf]) {
+                failures++;
+                continue;
+            }
+            addLandmark(leaf);
+        }
+    }
+
+    // the backward searches are independent, so each landmark is searched on its own thread
+    int k = landmarks_.size();
+    vector<vector<double>> backward(k);
+    parallelFor(k, threads, [&](int l, int thread) {
+        shortestDistances(csr, landmarks_[l], true, backward[l]);
+    });
+
+    from_.resize((size_t)n * k);
+    to_.resize((size_t)n * k);
+    for (int v = 0; v < n; v++) {
+        for (int l = 0; l < k; l++) {
+            from_[(size_t)v * k + l] = forward[l][v];
+            to_[(size_t)v * k + l] = backward[l][v];
+        }
+    }
+    for (int landmark : landmarks_) {
+        landmarkIDs_.push_back(csr.getID(landmark));
+    }
+}
+
+vector<int> Landmarks::getLandmarkIDs() const {
+    return landmarkIDs_;
+}
+
+double Landmarks::_bound(int from, int to, int landmark) const {
+    size_t k = landmarks_.size();
+    double inf = numeric_limits<double>::infinity();
+    double best = 0;
+    // d(from, to) >= d(L, to) - d(L, from), which is infinite if L reaches from but not to
+    double fromLandmark = from_[from * k + landmark];
+    if (fromLandmark < inf) { best = max(best, from_[to * k + landmark] - fromLandmark); }
+    // d(from, to) >= d(from, L) - d(to, L), which is infinite if to reaches L but from does not
+    double toLandmark = to_[to * k + landmark];
+    if (toLandmark < inf) { best = max(best, to_[from * k + landmark] - toLandmark); }
+    return best;
+}
+
+double Landmarks::lowerBound(int from, int to) const {
+    double best = 0;
+    for (size_t l = 0; l < landmarks_.size(); l++) {
+        best = max(best, _bound(from, to, l));
+    }
+    return best;
+}
+
+double Landmarks::lowerBound(int from, int to, const vector<int>& active) const {
+    double best = 0;
+    for (int l : active) {
+        best = max(best, _bound(from, to, l));
+    }
+    return best;
+}
+
+vector<int> Landmarks::activeLandmarks(int from, int to, int maxActive) const {
+    vector<pair<double, int>> bounds;
+    for (size_t l = 0; l < landmarks_.size(); l++) {
+        bounds.push_back(make_pair(-_bound(from, to, l), l));
+    }
+    sort(bounds.begin(), bounds.end());
+    vector<int> active;
+    for (size_t i = 0; i < bounds.size() && (int)i < maxActive; i++) {
+        active.push_back(bounds[i].second);
+    }
+    return active;
+}
+
+bool Landmarks::save(const string& filename) const {
+    ofstream out(filename, ios::binary);
+    if (!out) { return false; }
+    int32_t header[2] = {size_, (int32_t)landmarks_.size()};
+    out.write(LANDMARK_MAGIC, sizeof(LANDMARK_MAGIC));
+    out.write((const char*)&fingerprint_, sizeof(fingerprint_));
+    out.write((const char*)header, sizeof(header));
+    out.write((const char*)landmarks_.data(), landmarks_.size() * sizeof(int));
+    out.write((const char*)landmarkIDs_.data(), landmarkIDs_.size() * sizeof(int));
+    out.write((const char*)from_.data(), from_.size() * sizeof(double));
+    out.write((const char*)to_.data(), to_.size() * sizeof(double));
+    return (bool)out;
+}
+
+bool Landmarks::load(const string& filename, const Graph& g) {
+    ifstream in(filename, ios::binary);
+    if (!in) { return false; }
+    char magic[sizeof(LANDMARK_MAGIC)];
+    uint64_t fingerprint;
+    int32_t header[2];
+    in.read(magic, sizeof(magic));
+    in.read((char*)&fingerprint, sizeof(fingerprint));
+    in.read((char*)header, sizeof(header));
+    const CSRGraph& csr = g.csr();
+    if (!in || memcmp(magic, LANDMARK_MAGIC, sizeof(magic)) != 0 || fingerprint != csr.fingerprint()
+        || header[0] != csr.size() || header[1] < 0 || header[1] > header[0]) {
+        return false;
+    }
+    size_t n = header[0], k = header[1];
+    // the rest of the file must hold exactly the tables the header describes, so a corrupt count is caught
+    // before anything is allocated for it
+    streampos start = in.tellg();
+    in.seekg(0, ios::end);
+    size_t remaining = in.tellg() - start;
+    in.seekg(start);
+    if (remaining != 2 * k * sizeof(int) + 2 * n * k * sizeof(double)) { return false; }
+
+    vector<int> landmarks(k), landmarkIDs(k);
+    in.read((char*)landmarks.data(), k * sizeof(int));
+    in.read((char*)landmarkIDs.data(), k * sizeof(int));
+    if (!in) { return false; }
+    for (size_t l = 0; l < k; l++) {
+        if (landmarks[l] < 0 || landmarks[l] >= csr.size() || landmarkIDs[l] != csr.getID(landmarks[l])) {
+            return false;
+        }
+    }
+    vector<double> from(n * k), to(n * k);
+    in.read((char*)from.data(), from.size() * sizeof(double));
+    in.read((char*)to.data(), to.size() * sizeof(double));
+    if (!in) { return false; }
+
+    fingerprint_ = fingerprint;
+    size_ = n;
+    landmarks_.swap(landmarks);
+    landmarkIDs_.swap(landmarkIDs);
+    from_.swap(from);
+    to_.swap(to);
+    return true;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Class for ALT (A*, Landmarks, Triangle inequality) preprocessing
+ * Stores the distances from and to a handful of landmark airports, which give
+ * lower bounds on the distance between any two airports through the triangle inequality
+ */
+class Landmarks {
+    public:
+        /**
+        * @brief How the landmark airports are chosen
+        * FARTHEST repeatedly picks the airport farthest from the landmarks chosen so far
+        * AVOID picks airports in the parts of shortest path trees the bounds cover worst
+        */
+        enum Selection { FARTHEST, AVOID };
+
+        /**
+        * @brief Constructs an empty set of landmarks (no bounds until built or loaded)
+        */
+        Landmarks() : fingerprint_(0), size_(0) {}
+
+        /**
+        * @brief Chooses landmark airports and computes the distances from and to each of them
+        * Landmarks are only chosen among airports with connections
+        *
+        * @param g The graph to preprocess
+        * @param count How many landmarks to choose
+        * @param selection How to choose the landmarks
+        * @param threads How many threads to compute the distance tables with (0 for all hardware threads)
+        * @param seed The seed for the random choices made by AVOID
+        */
+        void build(const Graph& g, int count, Selection selection = FARTHEST, int threads = 0, unsigned seed = 1);
+
+        /**
+        * @brief Writes the landmark tables to a binary file
+        *
+        * @param filename The file to write
+        * @return bool Whether the file was written
+        */
+        bool save(const string& filename) const;
+
+        /**
+        * @brief Reads landmark tables written by save()
+        * The tables are only accepted if they were built for a graph with the same airports and connections
+        *
+        * @param filename The file to read
+        * @param g The graph the tables should belong to
+        * @return bool Whether the tables were loaded (if not, this is left unchanged)
+        */
+        bool load(const string& filename, const Graph& g);
+
+        /**
+        * @brief Determines if the tables were built for a snapshot
+        *
+        * @param csr The snapshot to check
+        * @return bool Whether the tables match the snapshot
+        */
+        bool matches(const CSRGraph& csr) const { return !landmarks_.empty() && csr.fingerprint() == fingerprint_; }
+
+        /**
+        * @brief Gets the IDs of the landmark airports
+        *
+        * @return vector<int> The landmark IDs
+        */
+        vector<int> getLandmarkIDs() const;
+
+        /**
+        * @brief Gets the number of landmarks
+        *
+        * @return int The number of landmarks
+        */
+        int count() const { return landmarks_.size(); }
+
+        /**
+        * @brief Gets a lower bound on the shortest distance between two airports
+        * Returns infinity when the tables prove there is no path
+        *
+        * @param from The first airport's dense index
+        * @param to The second airport's dense index
+        * @return double The lower bound
+        */
+        double lowerBound(int from, int to) const;
+
+        /**
+        * @brief Gets a lower bound using only some of the landmarks
+        *
+        * @param from The first airport's dense index
+        * @param to The second airport's dense index
+        * @param active The positions (not IDs) of the landmarks to use
+        * @return double The lower bound
+        */
+        double lowerBound(int from, int to, const vector<int>& active) const;
+
+        /**
+        * @brief Picks the landmarks giving the best bounds between two airports
+        * Using a few well-chosen landmarks keeps A* queries cheap while losing little pruning
+        *
+        * @param from The first airport's dense index
+        * @param to The second airport's dense index
+        * @param maxActive The maximum number of landmarks to pick
+        * @return vector<int> The positions of the chosen landmarks
+        */
+        vector<int> activeLandmarks(int from, int to, int maxActive) const;
+
+    private:
+        /**
+        * @brief The bound given by a single landmark
+        *
+        * @param from The first airport's dense index
+        * @param to The second airport's dense index
+        * @param landmark The landmark's position
+        * @return double The lower bound
+        */
+        double _bound(int from, int to, int landmark) const;
+
+        /**
+        * @brief fingerprint of the snapshot the tables were built for
+        */
+        uint64_t fingerprint_;
+        /**
+        * @brief number of airports in the snapshot the tables were built for
+        */
+        int size_;
+        /**
+        * @brief dense indices of the landmark airports
+        */
+        vector<int> landmarks_;
+        /**
+        * @brief landmarks' airport IDs, kept so the tables can be inspected after loading
+        */
+        vector<int> landmarkIDs_;
+        /**
+        * @brief distance from each landmark to each airport, stored airport-major (airport * count() + landmark)
+        */
+        vector<double> from_;
+        /**
+        * @brief distance from each airport to each landmark, stored airport-major
+        */
+        vector<double> to_;
+};
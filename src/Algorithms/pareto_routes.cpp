@@ -0,0 +1,89 @@
+#include "pareto_routes.h"
+#include "../SearchWorkspace.h"
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+vector<vector<int>> ParetoRoutes::getFront(const Graph& g, int source, int target, int maxLegs) {
+    distances_.clear();
+    legs_.clear();
+    labels_.clear();
+    heap_.clear();
+    labelCount_ = 0;
+    vector<vector<int>> front;
+    const CSRGraph& csr = g.csr();
+    int s = csr.getIndex(source);
+    int t = csr.getIndex(target);
+    if (s == -1 || t == -1 || maxLegs < 0 || !csr.mayReach(s, t)) { return front; }
+
+    // a new generation unsettles every airport in O(1)
+    if (settled_.size() != (size_t)csr.size() || ++generation_ == 0) {
+        settled_.assign(csr.size(), 0);
+        fewestLegs_.resize(csr.size());
+        generation_ = 1;
+    }
+
+    // fewest legs from every airport to the target, as distances in the thread's workspace (infinity if unreachable)
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.reset(csr.size());
+    vector<int>& queue = ws.queue();
+    ws.reach(t, 0, -1);
+    queue.push_back(t);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (int i = csr.inBegin(v); i < csr.inEnd(v); i++) {
+            int u = csr.source(i);
+            if (!ws.reached(u)) {
+                ws.reach(u, ws.distance(v) + 1, v);
+                queue.push_back(u);
+            }
+        }
+    }
+    // whether a label's itinerary could still end up on the front
+    auto promising = [&](int v, int legs) {
+        double fewest = legs + ws.distance(v);
+        return fewest <= maxLegs && !_dominated(t, (int)fewest);
+    };
+    if (!promising(s, 0)) { return front; }
+
+    typedef greater<tuple<double, int, int>> Later;
+    vector<int> found; // the target's settled labels, in settling order
+    labels_.push_back(Label{0, 0, s, -1});
+    heap_.push_back(make_tuple(0.0, 0, 0));
+    while (!heap_.empty()) {
+        int index = get<2>(heap_.front());
+        pop_heap(heap_.begin(), heap_.end(), Later());
+        heap_.pop_back();
+        Label label = labels_[index];
+        int v = label.node;
+        // anything settled earlier is no longer, so it dominates if it has no more legs
+        if (_dominated(v, label.legs) || !promising(v, label.legs)) { continue; }
+        settled_[v] = generation_;
+        fewestLegs_[v] = label.legs;
+        if (v == t) {
+            found.push_back(index);
+            continue;
+        }
+        int legs = label.legs + 1;
+        for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+            int adj = csr.target(e);
+            if (_dominated(adj, legs) || !promising(adj, legs)) { continue; }
+            double distance = label.distance + csr.weight(e);
+            labels_.push_back(Label{distance, legs, adj, index});
+            heap_.push_back(make_tuple(distance, legs, (int)labels_.size() - 1));
+            push_heap(heap_.begin(), heap_.end(), Later());
+        }
+    }
+    labelCount_ = labels_.size();
+
+    for (int index : found) {
+        vector<int> path;
+        for (int l = index; l != -1; l = labels_[l].parent) { path.push_back(csr.getID(labels_[l].node)); }
+        reverse(path.begin(), path.end());
+        front.push_back(path);
+        distances_.push_back(labels_[index].distance);
+        legs_.push_back(labels_[index].legs);
+    }
+    return front;
+}
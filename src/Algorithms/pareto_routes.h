@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+
+#include <vector>
+#include <tuple>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Class for multi-criteria routing: the Pareto front of itineraries over total distance and number of legs
+ * An itinerary is on the front if no other one is both no longer and has no more legs. Found by a
+ * label-setting search (Martins' algorithm): every partial itinerary is a label, and labels are settled in
+ * order of distance (then legs), so a label is dominated exactly when its airport already settled one with
+ * no more legs. Each airport therefore only keeps its fewest settled legs, checked in O(1). A backward
+ * breadth-first search from the target first gives every airport its fewest legs to the target, so labels
+ * that could only reach it with too many legs, or with no fewer legs than an itinerary already found, are
+ * dropped before they are queued.
+ *
+ * Labels live in one pool reused by every query, holding the index of the label they extend, so
+ * itineraries are rebuilt without storing them per label
+ */
+class ParetoRoutes {
+    public:
+        /**
+        * @brief Constructs a search with no front until the first query
+        */
+        ParetoRoutes() : generation_(0), labelCount_(0) {}
+
+        /**
+        * @brief Generates the Pareto front of itineraries from source to target
+        *
+        * @param g network of all airports
+        * @param source the source airport ID
+        * @param target the target airport ID
+        * @param maxLegs the most legs an itinerary may have
+        * @return chronological vectors of airport IDs from source to target, shortest (and most legs) first
+        * (empty if there is no itinerary with at most maxLegs legs)
+        */
+        vector<vector<int>> getFront(const Graph& g, int source, int target, int maxLegs = 6);
+
+        /**
+        * @brief distances of the itineraries on the last query's front
+        * @return The distance of each itinerary, in the same order as the front
+        */
+        const vector<double>& getDistances() const { return distances_; }
+
+        /**
+        * @brief number of legs of the itineraries on the last query's front
+        * @return The legs of each itinerary, in the same order as the front
+        */
+        const vector<int>& getLegs() const { return legs_; }
+
+        /**
+        * @brief number of labels the last query created
+        * @return The number of labels
+        */
+        long long labelCount() const { return labelCount_; }
+
+    private:
+        /**
+        * @brief A partial itinerary ending at an airport
+        */
+        struct Label {
+            double distance;
+            int legs;
+            int node; // dense index of the airport it ends at
+            int parent; // the label it extends (-1 at the source)
+        };
+
+        /**
+        * @brief Determines if an airport's settled labels dominate a label that is no shorter than them
+        *
+        * @param v The airport's dense index
+        * @param legs The label's legs
+        * @return bool Whether the label is dominated
+        */
+        bool _dominated(int v, int legs) const { return settled_[v] == generation_ && fewestLegs_[v] <= legs; }
+
+        vector<Label> labels_; // the pool, emptied (but not freed) by each query
+        vector<tuple<double, int, int>> heap_; // (distance, legs, label), smallest first
+        vector<uint32_t> settled_; // the generation each airport last settled a label in
+        vector<int> fewestLegs_; // the fewest legs of each airport's settled labels
+        uint32_t generation_;
+        vector<double> distances_;
+        vector<int> legs_;
+        long long labelCount_;
+};
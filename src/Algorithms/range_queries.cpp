@@ -0,0 +1,103 @@
+#include "range_queries.h"
+#include "../SearchWorkspace.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+using namespace std;
+
+vector<ReachableAirport> reachableWithin(const Graph& g, int source, double maxDistance, const SearchMask* mask) {
+    vector<ReachableAirport> reached;
+    const CSRGraph& csr = g.csr();
+    int s = csr.getIndex(source);
+    if (s == -1 || maxDistance < 0 || (mask && mask->nodeBanned(s))) { return reached; }
+
+    // parents are kept as positions in reached rather than dense indices, so each airport's legs come from its parent's
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.reset(csr.size());
+    vector<pair<double, int>>& qu = ws.heap();
+    ws.reach(s, 0, -1);
+    qu.push_back(make_pair(0.0, s));
+    while (!qu.empty()) {
+        pair<double, int> node = qu.front();
+        pop_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+        qu.pop_back();
+        int v = node.second;
+        if (ws.visited(v)) { continue; }
+        ws.visit(v);
+        int parent = ws.parent(v);
+        reached.push_back(ReachableAirport{csr.getID(v), node.first, parent == -1 ? 0 : reached[parent].legs + 1});
+
+        int position = reached.size() - 1;
+        for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+            int adj = csr.target(e);
+            if (mask && (mask->edgeBanned(e) || mask->nodeBanned(adj))) { continue; }
+            double alt = node.first + csr.weight(e);
+            if (alt <= maxDistance && alt < ws.distance(adj)) {
+                ws.reach(adj, alt, position);
+                qu.push_back(make_pair(alt, adj));
+                push_heap(qu.begin(), qu.end(), greater<pair<double, int>>());
+            }
+        }
+    }
+    return reached;
+}
+
+vector<ReachableAirport> reachableWithinLegs(const Graph& g, int source, int maxLegs, double maxDistance,
+    const SearchMask* mask) {
+    vector<ReachableAirport> reached;
+    const CSRGraph& csr = g.csr();
+    int s = csr.getIndex(source);
+    if (s == -1 || maxLegs < 0 || maxDistance < 0 || (mask && mask->nodeBanned(s))) { return reached; }
+
+    // an airport's parent holds the layer it was first reached in, which is its fewest legs
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.reset(csr.size());
+    vector<int>& ball = ws.queue(); // every airport reached, in the order first reached
+    ws.reach(s, 0, 0);
+    ball.push_back(s);
+    // the airports that improved in the last layer, with their distances at the end of it
+    vector<pair<int, double>> frontier(1, make_pair(s, 0.0));
+    vector<int> improved;
+    for (int legs = 1; legs <= maxLegs && !frontier.empty(); legs++) {
+        improved.clear();
+        for (const pair<int, double>& node : frontier) {
+            int v = node.first;
+            for (int e = csr.outBegin(v); e < csr.outEnd(v); e++) {
+                int adj = csr.target(e);
+                if (mask && (mask->edgeBanned(e) || mask->nodeBanned(adj))) { continue; }
+                double alt = node.second + csr.weight(e);
+                if (alt > maxDistance || alt >= ws.distance(adj)) { continue; }
+                if (!ws.reached(adj)) {
+                    ball.push_back(adj);
+                    ws.reach(adj, alt, legs);
+                } else {
+                    ws.reach(adj, alt, ws.parent(adj));
+                }
+                improved.push_back(adj);
+            }
+        }
+        // the distances are read once the layer is done, so no path in the next layer uses two legs from this one
+        sort(improved.begin(), improved.end());
+        improved.erase(unique(improved.begin(), improved.end()), improved.end());
+        frontier.clear();
+        for (int v : improved) { frontier.push_back(make_pair(v, ws.distance(v))); }
+    }
+
+    for (int v : ball) { reached.push_back(ReachableAirport{csr.getID(v), ws.distance(v), ws.parent(v)}); }
+    sort(reached.begin(), reached.end(), [](const ReachableAirport& a, const ReachableAirport& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.id < b.id);
+    });
+    return reached;
+}
+
+vector<vector<int>> isochrones(const Graph& g, int source, const vector<double>& bounds) {
+    vector<vector<int>> bands(bounds.size());
+    if (bounds.empty()) { return bands; }
+    size_t band = 0;
+    for (const ReachableAirport& airport : reachableWithin(g, source, bounds.back())) {
+        while (airport.distance > bounds[band]) { band++; }
+        bands[band].push_back(airport.id);
+    }
+    return bands;
+}
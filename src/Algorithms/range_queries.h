@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../SearchMask.h"
+
+#include <vector>
+#include <limits>
+
+using namespace std;
+
+// Range queries: every airport reachable from an origin within a distance or leg budget.
+// The searches stop expanding at the budget and run in the thread's SearchWorkspace, so a
+// query costs time proportional to the airports and connections inside the budget, not the graph
+
+/**
+ * @brief An airport found by a range query
+ */
+struct ReachableAirport {
+    int id;
+    double distance; // shortest distance from the origin (within the leg budget, if there is one)
+    int legs; // legs of that shortest path for reachableWithin, fewest legs for reachableWithinLegs
+};
+
+/**
+* @brief Finds every airport within a travel distance of an origin
+* A Dijkstra search that never queues anything beyond the budget
+*
+* @param g network of all airports
+* @param source the origin airport ID
+* @param maxDistance the most distance to travel
+* @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
+* @return the airports reached, including the origin, in order of distance (empty if the origin is not in the graph)
+*/
+vector<ReachableAirport> reachableWithin(const Graph& g, int source, double maxDistance, const SearchMask* mask = nullptr);
+
+/**
+* @brief Finds every airport within a number of legs of an origin, with its shortest distance using at most that many legs
+* Bellman-Ford by layers that only relaxes the airports that improved in the previous layer
+*
+* @param g network of all airports
+* @param source the origin airport ID
+* @param maxLegs the most legs to travel
+* @param maxDistance the most distance to travel as well (infinity for no limit)
+* @param mask airports and connections to avoid, cleared for g's snapshot (nullptr to use them all)
+* @return the airports reached, including the origin, in order of distance (empty if the origin is not in the graph)
+*/
+vector<ReachableAirport> reachableWithinLegs(const Graph& g, int source, int maxLegs,
+    double maxDistance = numeric_limits<double>::infinity(), const SearchMask* mask = nullptr);
+
+/**
+* @brief Groups the airports around an origin into distance bands (isochrones)
+*
+* @param g network of all airports
+* @param source the origin airport ID
+* @param bounds the upper distance of each band, in increasing order
+* @return the airport IDs of each band: band i holds airports farther than bounds[i - 1] and at most bounds[i],
+* in order of distance (the origin is in band 0)
+*/
+vector<vector<int>> isochrones(const Graph& g, int source, const vector<double>& bounds);
@@ -0,0 +1,105 @@
+#include "reachability.h"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+void ReachabilityIndex::build(const Graph& g) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    int count = csr.strongComponents();
+    fingerprint_ = csr.fingerprint();
+    ids_ = csr.getIDs();
+
+    // the condensation's connections, grouped by the component they leave
+    vector<pair<int, int>> arcs;
+    for (int u = 0; u < n; u++) {
+        for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+            int from = csr.strongComponent(u), to = csr.strongComponent(csr.target(e));
+            if (from != to) { arcs.push_back(make_pair(from, to)); }
+        }
+    }
+    sort(arcs.begin(), arcs.end());
+    arcs.erase(unique(arcs.begin(), arcs.end()), arcs.end());
+    vector<int> arcOffsets(count + 1, 0);
+    for (const pair<int, int>& arc : arcs) { arcOffsets[arc.first + 1]++; }
+    for (int c = 0; c < count; c++) { arcOffsets[c + 1] += arcOffsets[c]; }
+
+    // depth-first search over the condensation; a component's label is made when it finishes, after
+    // everything it reaches, and is appended in post-order so the labels line up with the new numbers
+    vector<int> post(count, -1), first(count, 0);
+    vector<pair<int, int>> calls; // (component, next arc to follow)
+    vector<Interval> gathered;
+    offsets_.assign(1, 0);
+    intervals_.clear();
+    int finished = 0;
+    // Tarjan numbers sources highest, so starting from them gives the fewest trees
+    for (int root = count - 1; root >= 0; root--) {
+        if (post[root] != -1) { continue; }
+        calls.push_back(make_pair(root, arcOffsets[root]));
+        first[root] = finished;
+        post[root] = -2; // discovered
+        while (!calls.empty()) {
+            int c = calls.back().first;
+            int& arc = calls.back().second;
+            if (arc < arcOffsets[c + 1]) {
+                int next = arcs[arc++].second;
+                if (post[next] == -1) {
+                    first[next] = finished;
+                    post[next] = -2;
+                    calls.push_back(make_pair(next, arcOffsets[next]));
+                }
+                continue;
+            }
+            calls.pop_back();
+            post[c] = finished++;
+
+            // the component's own subtree, and whatever its connections lead to
+            gathered.assign(1, Interval{first[c], post[c]});
+            for (int i = arcOffsets[c]; i < arcOffsets[c + 1]; i++) {
+                int next = post[arcs[i].second];
+                gathered.insert(gathered.end(), intervals_.begin() + offsets_[next],
+                    intervals_.begin() + offsets_[next + 1]);
+            }
+            sort(gathered.begin(), gathered.end(), [](const Interval& a, const Interval& b) {
+                return a.first < b.first;
+            });
+            size_t start = intervals_.size();
+            for (const Interval& interval : gathered) {
+                if (intervals_.size() > start && interval.first <= intervals_.back().last + 1) {
+                    intervals_.back().last = max(intervals_.back().last, interval.last);
+                } else {
+                    intervals_.push_back(interval);
+                }
+            }
+            offsets_.push_back(intervals_.size());
+        }
+    }
+    intervals_.shrink_to_fit();
+
+    component_.resize(n);
+    for (int v = 0; v < n; v++) { component_[v] = post[csr.strongComponent(v)]; }
+}
+
+bool ReachabilityIndex::reachesIndex(int from, int to) const {
+    int target = component_[to];
+    auto begin = intervals_.begin() + offsets_[component_[from]];
+    auto end = intervals_.begin() + offsets_[component_[from] + 1];
+    // the last interval starting at or before the target's number is the only one that can hold it
+    auto it = upper_bound(begin, end, target, [](int number, const Interval& interval) {
+        return number < interval.first;
+    });
+    return it != begin && (it - 1)->last >= target;
+}
+
+bool ReachabilityIndex::reaches(int source, int target) const {
+    auto s = lower_bound(ids_.begin(), ids_.end(), source);
+    auto t = lower_bound(ids_.begin(), ids_.end(), target);
+    if (s == ids_.end() || *s != source || t == ids_.end() || *t != target) { return false; }
+    return reachesIndex(s - ids_.begin(), t - ids_.begin());
+}
+
+size_t ReachabilityIndex::bytes() const {
+    return (ids_.capacity() + component_.capacity() + offsets_.capacity()) * sizeof(int)
+        + intervals_.capacity() * sizeof(Interval);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../Graph.h"
+#include "../CSRGraph.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/**
+ * Class for exact directed reachability ("can you get from A to B at all?") without searching
+ * The graph is condensed into the DAG of its strongly connected components, which is numbered by a depth-first
+ * post-order. Every component's descendants in the depth-first forest then have consecutive numbers, so each
+ * component is labelled with the few intervals of numbers that cover every component it reaches: its own
+ * subtree plus the labels of the components it reaches through other connections, merged. A query is a binary
+ * search of the target component's number in the source component's intervals.
+ *
+ * Airport networks condense to one large component and many small ones hanging off it, so most labels are a
+ * single interval and the index stays a few bytes per airport
+ */
+class ReachabilityIndex {
+    public:
+        /**
+        * @brief Constructs an empty index (no airport reaches anything until built)
+        */
+        ReachabilityIndex() : fingerprint_(0) {}
+
+        /**
+        * @brief Condenses a graph and labels its components
+        *
+        * @param g network of all airports
+        */
+        void build(const Graph& g);
+
+        /**
+        * @brief Determines if there is a path from one airport to another
+        *
+        * @param source the origin airport ID
+        * @param target the destination airport ID
+        * @return bool Whether there is a path (every airport reaches itself; false if either is not in the index)
+        */
+        bool reaches(int source, int target) const;
+
+        /**
+        * @brief Determines if there is a path from one airport to another, by dense index of the built snapshot
+        *
+        * @param from The origin's dense index
+        * @param to The destination's dense index
+        * @return bool Whether there is a path
+        */
+        bool reachesIndex(int from, int to) const;
+
+        /**
+        * @brief Gets the number of components in the condensation
+        * @return The number of components
+        */
+        int components() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+        /**
+        * @brief Gets the total number of intervals over all labels
+        * @return The number of intervals
+        */
+        size_t intervals() const { return intervals_.size(); }
+
+        /**
+        * @brief Gets the memory the index holds
+        * @return The size in bytes
+        */
+        size_t bytes() const;
+
+        /**
+        * @brief Determines if the index was built from a snapshot
+        *
+        * @param csr The snapshot to check
+        * @return bool Whether the index matches the snapshot
+        */
+        bool matches(const CSRGraph& csr) const { return csr.fingerprint() == fingerprint_; }
+
+    private:
+        /**
+        * @brief A range of component numbers, inclusive
+        */
+        struct Interval {
+            int first, last;
+        };
+
+        uint64_t fingerprint_; // the fingerprint of the snapshot built from
+        vector<int> ids_; // the snapshot's airport IDs, by dense index
+        vector<int> component_; // each airport's component, numbered in post-order
+        vector<int> offsets_; // where each component's intervals start (components() + 1 entries)
+        vector<Interval> intervals_; // every component's intervals, sorted and disjoint
+};
@@ -0,0 +1,40 @@
+#include "shortest_paths.h"
+#include <queue>
+#include <limits>
+#include <utility>
+
+using namespace std;
+
+void shortestDistances(const CSRGraph& csr, int source, bool reverse, vector<double>& distances,
+    vector<int>* parents, const SearchMask* mask) {
+    int n = csr.size();
+    distances.assign(n, numeric_limits<double>::infinity());
+    if (parents) { parents->assign(n, -1); }
+    if (mask && mask->nodeBanned(source)) { return; }
+
+    typedef pair<double, int> QueueNode;
+    priority_queue<QueueNode, vector<QueueNode>, greater<QueueNode>> qu;
+    distances[source] = 0;
+    qu.push(QueueNode(0, source));
+
+    while (!qu.empty()) {
+        QueueNode node = qu.top();
+        qu.pop();
+        int u = node.second;
+        // skips stale queue entries
+        if (node.first > distances[u]) { continue; }
+        int begin = reverse ? csr.inBegin(u) : csr.outBegin(u);
+        int end = reverse ? csr.inEnd(u) : csr.outEnd(u);
+        for (int i = begin; i < end; i++) {
+            int v = reverse ? csr.source(i) : csr.target(i);
+            int edge = reverse ? csr.inEdge(i) : i;
+            if (mask && (mask->edgeBanned(edge) || mask->nodeBanned(v))) { continue; }
+            double alt = node.first + csr.weight(edge);
+            if (alt < distances[v]) {
+                distances[v] = alt;
+                if (parents) { (*parents)[v] = u; }
+                qu.push(QueueNode(alt, v));
+            }
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../CSRGraph.h"
+#include "../SearchMask.h"
+
+#include <vector>
+
+using namespace std;
+
+/**
+* @brief Computes the shortest distance from a source airport to every airport
+* This is a one-to-all Dijkstra search over a CSR snapshot, used by the preprocessing steps
+* that need whole shortest path trees rather than single paths
+*
+* @param csr The snapshot to search
+* @param source The source airport's dense index
+* @param reverse Whether to follow connections backwards, giving each airport's distance to the source
+* @param distances Filled with each airport's distance (infinity if unreachable)
+* @param parents If given, filled with each airport's previous airport in the tree (-1 for none)
+* @param mask If given, airports and connections to avoid (every airport is unreachable if the source is banned)
+*/
+void shortestDistances(const CSRGraph& csr, int source, bool reverse, vector<double>& distances,
+    vector<int>* parents = nullptr, const SearchMask* mask = nullptr);
@@ -0,0 +1,180 @@
+#include "CSRGraph.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+/**
+* @brief Mixes a value into an FNV-1a hash
+*
+* @param hash The running hash
+* @param value The value to mix in
+*/
+static void mix(uint64_t & hash, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (8 * i)) & 0xff;
+        hash *= 1099511628211ULL;
+    }
+}
+
+CSRGraph::CSRGraph(const Graph& g) : spherical_(g.spherical_) {
+    ids_.reserve(g.nodes_.size());
+    for (auto it = g.nodes_.begin(); it != g.nodes_.end(); it++) {
+        ids_.push_back(it->first);
+    }
+    sort(ids_.begin(), ids_.end());
+
+    int n = ids_.size();
+    latitudes_.resize(n);
+    longitudes_.resize(n);
+    outOffsets_.assign(n + 1, 0);
+    inOffsets_.assign(n + 1, 0);
+
+    // gather each airport's connections sorted by index
+    vector<pair<int, double>> adjacent;
+    for (int u = 0; u < n; u++) {
+        const Graph::GraphNode& node = g.nodes_.at(ids_[u]);
+        latitudes_[u] = node.latitude_;
+        longitudes_[u] = node.longitude_;
+        adjacent.clear();
+        for (auto it = node.connections_.begin(); it != node.connections_.end(); it++) {
+            int v = getIndex(it->first);
+            // connections to removed airports and to itself are skipped
+            if (v != -1 && v != u) {
+                adjacent.push_back(make_pair(v, it->second));
+            }
+        }
+        sort(adjacent.begin(), adjacent.end());
+        for (auto& edge : adjacent) {
+            targets_.push_back(edge.first);
+            weights_.push_back(edge.second);
+            inOffsets_[edge.first + 1]++;
+        }
+        outOffsets_[u + 1] = targets_.size();
+    }
+
+    // build the incoming arrays by counting sort, which keeps each list sorted by origin
+    for (int v = 0; v < n; v++) {
+        inOffsets_[v + 1] += inOffsets_[v];
+    }
+    sources_.resize(targets_.size());
+    inEdges_.resize(targets_.size());
+    vector<int> next(inOffsets_.begin(), inOffsets_.end() - 1);
+    for (int u = 0; u < n; u++) {
+        for (int e = outOffsets_[u]; e < outOffsets_[u + 1]; e++) {
+            int position = next[targets_[e]]++;
+            sources_[position] = u;
+            inEdges_[position] = e;
+        }
+    }
+
+    fingerprint_ = 14695981039346656037ULL;
+    mix(fingerprint_, n);
+    mix(fingerprint_, spherical_);
+    for (int u = 0; u < n; u++) {
+        mix(fingerprint_, ids_[u]);
+        mix(fingerprint_, outOffsets_[u + 1]);
+    }
+    for (size_t e = 0; e < targets_.size(); e++) {
+        uint64_t bits;
+        memcpy(&bits, &weights_[e], sizeof(bits));
+        mix(fingerprint_, targets_[e]);
+        mix(fingerprint_, bits);
+    }
+
+    _components();
+}
+
+void CSRGraph::_components() {
+    int n = ids_.size();
+    // weak: a breadth-first search over connections in both directions from each unlabeled airport
+    weak_.assign(n, -1);
+    weakCount_ = 0;
+    vector<int> queue;
+    for (int start = 0; start < n; start++) {
+        if (weak_[start] != -1) { continue; }
+        weak_[start] = weakCount_;
+        queue.assign(1, start);
+        for (size_t front = 0; front < queue.size(); front++) {
+            int u = queue[front];
+            for (int e = outOffsets_[u]; e < outOffsets_[u + 1]; e++) {
+                if (weak_[targets_[e]] == -1) {
+                    weak_[targets_[e]] = weakCount_;
+                    queue.push_back(targets_[e]);
+                }
+            }
+            for (int i = inOffsets_[u]; i < inOffsets_[u + 1]; i++) {
+                if (weak_[sources_[i]] == -1) {
+                    weak_[sources_[i]] = weakCount_;
+                    queue.push_back(sources_[i]);
+                }
+            }
+        }
+        weakCount_++;
+    }
+
+    // strong: Tarjan's algorithm with an explicit stack of (airport, next edge to follow)
+    strong_.assign(n, -1);
+    strongCount_ = 0;
+    vector<int> order(n, -1), low(n, 0), members;
+    vector<bool> onStack(n, false);
+    vector<pair<int, int>> calls;
+    int visited = 0;
+    for (int start = 0; start < n; start++) {
+        if (order[start] != -1) { continue; }
+        calls.push_back(make_pair(start, outOffsets_[start]));
+        order[start] = low[start] = visited++;
+        members.push_back(start);
+        onStack[start] = true;
+        while (!calls.empty()) {
+            int u = calls.back().first;
+            int& e = calls.back().second;
+            if (e < outOffsets_[u + 1]) {
+                int v = targets_[e++];
+                if (order[v] == -1) {
+                    order[v] = low[v] = visited++;
+                    members.push_back(v);
+                    onStack[v] = true;
+                    calls.push_back(make_pair(v, outOffsets_[v]));
+                } else if (onStack[v]) {
+                    low[u] = min(low[u], order[v]);
+                }
+                continue;
+            }
+            // u is finished: it roots a component if nothing below it reached further up
+            calls.pop_back();
+            if (!calls.empty()) {
+                int parent = calls.back().first;
+                low[parent] = min(low[parent], low[u]);
+            }
+            if (low[u] == order[u]) {
+                int v;
+                do {
+                    v = members.back();
+                    members.pop_back();
+                    onStack[v] = false;
+                    strong_[v] = strongCount_;
+                } while (v != u);
+                strongCount_++;
+            }
+        }
+    }
+}
+
+int CSRGraph::getIndex(int id) const {
+    auto it = lower_bound(ids_.begin(), ids_.end(), id);
+    if (it == ids_.end() || *it != id) {
+        return -1;
+    }
+    return it - ids_.begin();
+}
+
+int CSRGraph::findEdge(int from, int to) const {
+    auto begin = targets_.begin() + outOffsets_[from];
+    auto end = targets_.begin() + outOffsets_[from + 1];
+    auto it = lower_bound(begin, end, to);
+    if (it == end || *it != to) {
+        return -1;
+    }
+    return it - targets_.begin();
+}
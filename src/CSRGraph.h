@@ -0,0 +1,243 @@
+#pragma once
+#include "Graph.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief A compressed sparse row (CSR) snapshot of a Graph
+ * Airports are renumbered to dense indices 0 to size() - 1 in increasing ID order, and
+ * each airport's outgoing and incoming connections are stored contiguously, sorted by index
+ * (so iterating them visits airports in the same order as Graph::getConnections).
+ * Self-connections are dropped since they never lie on a shortest path.
+ * The snapshot also labels every airport with its weakly and strongly connected component, so
+ * searches can reject most pairs with no path in O(1) (see mayReach()).
+ * The snapshot does not change if the Graph it was built from is modified afterwards
+ */
+class CSRGraph {
+public:
+    /**
+    * @brief Constructs an empty snapshot
+    */
+    CSRGraph() : spherical_(true), fingerprint_(0), weakCount_(0), strongCount_(0) {}
+    /**
+    * @brief Constructs a snapshot of a graph
+    *
+    * @param g The graph to take a snapshot of
+    */
+    explicit CSRGraph(const Graph& g);
+
+    /**
+    * @brief Gets the number of airports in the snapshot
+    *
+    * @return int The number of airports
+    */
+    int size() const { return ids_.size(); }
+    /**
+    * @brief Gets the number of connections in the snapshot
+    *
+    * @return int The number of connections
+    */
+    int edges() const { return targets_.size(); }
+    /**
+    * @brief Gets the airport ID of a dense index
+    *
+    * @param index The dense index (must be in range)
+    * @return int The airport's ID
+    */
+    int getID(int index) const { return ids_[index]; }
+    /**
+    * @brief Gets the dense index of an airport ID
+    *
+    * @param id The airport's ID
+    * @return int The dense index, or -1 if the airport is not in the snapshot
+    */
+    int getIndex(int id) const;
+    /**
+    * @brief Gets all airport IDs in index order (which is increasing ID order)
+    *
+    * @return vector<int> The airport IDs
+    */
+    const std::vector<int>& getIDs() const { return ids_; }
+
+    /**
+    * @brief Gets the first outgoing connection of an airport
+    * The outgoing connections of index are the edges outBegin(index) to outEnd(index) - 1
+    *
+    * @param index The airport's dense index
+    * @return int The first edge number
+    */
+    int outBegin(int index) const { return outOffsets_[index]; }
+    /**
+    * @brief Gets one past the last outgoing connection of an airport
+    *
+    * @param index The airport's dense index
+    * @return int One past the last edge number
+    */
+    int outEnd(int index) const { return outOffsets_[index + 1]; }
+    /**
+    * @brief Gets the airport an edge leads to
+    *
+    * @param edge The edge number
+    * @return int The dense index of the edge's destination
+    */
+    int target(int edge) const { return targets_[edge]; }
+    /**
+    * @brief Gets the distance of an edge
+    *
+    * @param edge The edge number
+    * @return double The distance
+    */
+    double weight(int edge) const { return weights_[edge]; }
+
+    /**
+    * @brief Gets the first incoming connection of an airport
+    * The incoming connections of index are inBegin(index) to inEnd(index) - 1
+    *
+    * @param index The airport's dense index
+    * @return int The first incoming position
+    */
+    int inBegin(int index) const { return inOffsets_[index]; }
+    /**
+    * @brief Gets one past the last incoming connection of an airport
+    *
+    * @param index The airport's dense index
+    * @return int One past the last incoming position
+    */
+    int inEnd(int index) const { return inOffsets_[index + 1]; }
+    /**
+    * @brief Gets the airport an incoming connection comes from
+    *
+    * @param position The incoming position
+    * @return int The dense index of the connection's origin
+    */
+    int source(int position) const { return sources_[position]; }
+    /**
+    * @brief Gets the edge number of an incoming connection
+    *
+    * @param position The incoming position
+    * @return int The edge number of the same connection in the outgoing arrays
+    */
+    int inEdge(int position) const { return inEdges_[position]; }
+    /**
+    * @brief Finds the edge between two airports
+    *
+    * @param from The origin's dense index
+    * @param to The destination's dense index
+    * @return int The edge number, or -1 if they are not connected
+    */
+    int findEdge(int from, int to) const;
+
+    /**
+    * @brief Gets the number of connections leaving an airport
+    *
+    * @param index The airport's dense index
+    * @return int The out-degree
+    */
+    int outDegree(int index) const { return outEnd(index) - outBegin(index); }
+    /**
+    * @brief Gets the number of connections arriving at an airport
+    *
+    * @param index The airport's dense index
+    * @return int The in-degree
+    */
+    int inDegree(int index) const { return inEnd(index) - inBegin(index); }
+
+    /**
+    * @brief Gets the latitude of an airport
+    *
+    * @param index The airport's dense index
+    * @return double The latitude
+    */
+    double getLatitude(int index) const { return latitudes_[index]; }
+    /**
+    * @brief Gets the longitude of an airport
+    *
+    * @param index The airport's dense index
+    * @return double The longitude
+    */
+    double getLongitude(int index) const { return longitudes_[index]; }
+    /**
+    * @brief Gets whether distances were calculated on a sphere or 2D plane
+    *
+    * @return bool Whether the graph was spherical
+    */
+    bool getSpherical() const { return spherical_; }
+    /**
+    * @brief Calculates the straight-line distance between two airports
+    * Since every connection's distance is the straight-line distance between its airports,
+    * this is a lower bound on the shortest path distance
+    *
+    * @param a The first airport's dense index
+    * @param b The second airport's dense index
+    * @return double The straight-line distance
+    */
+    double straightDistance(int a, int b) const {
+        return Graph::coordinateDistance(latitudes_[a], longitudes_[a], latitudes_[b], longitudes_[b], spherical_);
+    }
+
+    /**
+    * @brief Gets the weakly connected component of an airport (airports linked ignoring direction)
+    *
+    * @param index The airport's dense index
+    * @return int The component, from 0 to weakComponents() - 1
+    */
+    int weakComponent(int index) const { return weak_[index]; }
+    /**
+    * @brief Gets the number of weakly connected components
+    *
+    * @return int The number of components
+    */
+    int weakComponents() const { return weakCount_; }
+    /**
+    * @brief Gets the strongly connected component of an airport (airports that can all reach each other)
+    * Components are numbered in reverse topological order: a connection between two components
+    * always leads from a higher number to a lower one
+    *
+    * @param index The airport's dense index
+    * @return int The component, from 0 to strongComponents() - 1
+    */
+    int strongComponent(int index) const { return strong_[index]; }
+    /**
+    * @brief Gets the number of strongly connected components
+    *
+    * @return int The number of components
+    */
+    int strongComponents() const { return strongCount_; }
+    /**
+    * @brief Checks in O(1) whether there may be a path from one airport to another
+    * False means there is certainly no path; true means there is one if both airports are in the
+    * same strongly connected component, and there may be one otherwise
+    *
+    * @param from The origin's dense index
+    * @param to The destination's dense index
+    * @return bool Whether a path is possible
+    */
+    bool mayReach(int from, int to) const { return weak_[from] == weak_[to] && strong_[from] >= strong_[to]; }
+
+    /**
+    * @brief Gets a hash of the airports and connections in the snapshot
+    * Used to check that precomputed data belongs to this graph
+    *
+    * @return uint64_t The fingerprint
+    */
+    uint64_t fingerprint() const { return fingerprint_; }
+
+private:
+    /**
+    * @brief Labels the weakly (breadth-first) and strongly (Tarjan's algorithm, without recursion) connected components
+    */
+    void _components();
+
+    bool spherical_; // Whether the distances were calculated on a sphere or 2D plane
+    uint64_t fingerprint_; // The hash of the airports and connections
+    std::vector<int> ids_; // Maps each dense index to its airport ID (sorted)
+    std::vector<double> latitudes_, longitudes_; // Each airport's coordinates
+    std::vector<int> outOffsets_; // Where each airport's outgoing connections start (size() + 1 entries)
+    std::vector<int> targets_; // The destination of each edge
+    std::vector<double> weights_; // The distance of each edge
+    std::vector<int> inOffsets_; // Where each airport's incoming connections start (size() + 1 entries)
+    std::vector<int> sources_; // The origin of each incoming connection
+    std::vector<int> inEdges_; // The edge number of each incoming connection
+    std::vector<int> weak_, strong_; // Each airport's weakly and strongly connected component
+    int weakCount_, strongCount_;
+};
@@ -1,4 +1,5 @@
 #include "Graph.h"
+#include "CSRGraph.h"
 #include <cmath>
 #include <map>
 #include <algorithm>
@@ -12,29 +13,44 @@ double Graph::GraphNode::_connectionDistance(int id) const {
 void Graph::addNode(int id, string name, double latitude, double longitude) {
     GraphNode node = GraphNode(name, latitude, longitude);
     nodes_[id] = node;
+    _invalidate();
 }
 
 void Graph::removeNode(int id) {
-    GraphNode toRemove = nodes_.at(id);
-    numConnections_ -= toRemove.connections_.size();
+    numConnections_ -= nodes_.at(id).connections_.size();
     nodes_.erase(id);
     for (auto it = nodes_.begin(); it != nodes_.end(); it++) {
-        GraphNode node = it->second;
-        if (node.connections_.find(id) != node.connections_.end()) {
-            node.connections_.erase(id);
+        // drops the connections into the removed airport
+        if (it->second.connections_.erase(id) > 0) {
             numConnections_--;
         }
     }
+    _invalidate();
 }
 
 void Graph::connect(int id1, int id2) {
     nodes_[id1].connections_[id2] = _distance(id1, id2);
     numConnections_++;
+    _invalidate();
+}
+
+void Graph::setSpherical(bool spherical) {
+    spherical_ = spherical;
+    for (auto& node : nodes_) {
+        for (auto& connection : node.second.connections_) {
+            connection.second = _distance(node.first, connection.first);
+        }
+    }
+    _invalidate();
 }
 
 void Graph::disconnect(int id1, int id2) {
-    nodes_[id1].connections_.erase(id2);
+    auto it = nodes_.find(id1);
+    if (it == nodes_.end() || it->second.connections_.erase(id2) == 0) {
+        return;
+    }
     numConnections_--;
+    _invalidate();
 }
 
 vector<int> Graph::getIDs(bool sorted) const {
@@ -48,7 +64,7 @@ vector<int> Graph::getIDs(bool sorted) const {
 
 vector<int> Graph::getConnections(int id, bool sorted) const {
     vector<int> ids;
-    GraphNode gn = nodes_.at(id);
+    const GraphNode& gn = nodes_.at(id);
     for (auto it = gn.connections_.begin(); it != gn.connections_.end(); it++) {
         ids.push_back(it->first);
     }
@@ -60,23 +76,40 @@ bool Graph::connectedTo(int id1, int id2) const {
     return nodes_.at(id1)._connectedTo(id2);
 }
 
+const CSRGraph& Graph::csr() const {
+    shared_ptr<const CSRGraph> snapshot = atomic_load(&csr_);
+    if (!snapshot) {
+        // two threads may both build a snapshot here; only the first one stored is kept, and every thread
+        // returns that one, so the reference stays owned by the graph until it is next modified
+        shared_ptr<const CSRGraph> built = make_shared<const CSRGraph>(*this);
+        if (atomic_compare_exchange_strong(&csr_, &snapshot, built)) {
+            snapshot = built;
+        }
+    }
+    return *snapshot;
+}
+
 double Graph::_distance(int id1, int id2) const {
-    GraphNode a = nodes_.at(id1);
-    GraphNode b = nodes_.at(id2);
-    if (spherical_) {
+    const GraphNode& a = nodes_.at(id1);
+    const GraphNode& b = nodes_.at(id2);
+    return coordinateDistance(a.latitude_, a.longitude_, b.latitude_, b.longitude_, spherical_);
+}
+
+double Graph::coordinateDistance(double lat1, double lon1, double lat2, double lon2, bool spherical) {
+    if (spherical) {
         double PI = 4*atan(1);
         //haversine formula
         double EARTH_RADIUS = 6378.1;
-        double lat1 = a.latitude_ * PI/180;
-        double lat2 = b.latitude_ * PI/180;
+        double deltalong = (lon2 - lon1) * PI/180;
+        lat1 = lat1 * PI/180;
+        lat2 = lat2 * PI/180;
         double deltalat = lat1 - lat2;
-        double deltalong = (b.longitude_ - a.longitude_) * PI/180;
         double haversine1 = pow(sin(deltalat/2),2)+cos(lat1)*cos(lat2)*pow(sin(deltalong/2),2);
         double haversine2 = 2*atan2(sqrt(haversine1), sqrt(1-haversine1));
         return haversine2 * EARTH_RADIUS;
     } else {
-        double deltalat = a.latitude_ - b.latitude_;
-        double deltalong = a.longitude_ - b.longitude_;
+        double deltalat = lat1 - lat2;
+        double deltalong = lon1 - lon2;
         return sqrt(pow(deltalat, 2) + pow(deltalong, 2));
     }
 }
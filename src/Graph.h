@@ -5,12 +5,16 @@
 #include <utility>
 #include <iostream>
 #include <limits>
+#include <memory>
+
+class CSRGraph;
 
 /**
  * @brief Stores all airports and their connections
  * This Graph is directional and stores distances
  */
 class Graph {
+    friend class CSRGraph;
 private:
     /**
     * @brief Stores the data of an airport and its connections
@@ -64,10 +68,11 @@ public:
     bool getSpherical() { return spherical_; }
     /**
     * @brief Setter for the spherical property
+    * Every connection's distance is recalculated, so distances and straight-line bounds use the same metric
     *
     * @param spherical Whether the distance calculation should be done on a sphere or 2D plane
     */
-    void setSpherical(bool spherical) { spherical_ = spherical; } 
+    void setSpherical(bool spherical);
     /**
      * @brief Adds an airport to the graph without any connections
      * 
@@ -92,10 +97,10 @@ public:
     void connect(int id1, int id2);
     /**
      * @brief Removes a connection from one airport to another (does not go both ways)
-     * The airports must be connected in the first place
+     * Does nothing if the airports are not connected
      * 
-     * @param id1 The ID of the starting airport (must be in graph)
-     * @param id2 The ID of the ending airport (must be in graph)
+     * @param id1 The ID of the starting airport
+     * @param id2 The ID of the ending airport
      */
     void disconnect(int id1, int id2);
     /**
@@ -178,10 +183,37 @@ public:
     */
     bool inGraph(int id) const { return nodes_.find(id) != nodes_.end(); }
 
+    /**
+    * @brief Gets a compressed sparse row snapshot of the graph, built on first use
+    * The snapshot is cached and shared between copies of the graph until the graph is modified,
+    * at which point references to the old snapshot must no longer be used
+    *
+    * @return CSRGraph The snapshot of the graph
+    */
+    const CSRGraph& csr() const;
+
+    /**
+    * @brief Calculates the straight-line distance between two coordinates
+    * This is the same distance that connect() assigns to a connection
+    *
+    * @param lat1 The first latitude
+    * @param lon1 The first longitude
+    * @param lat2 The second latitude
+    * @param lon2 The second longitude
+    * @param spherical Whether the distance calculation should be done on a sphere or 2D plane
+    * @return double The distance between the coordinates
+    */
+    static double coordinateDistance(double lat1, double lon1, double lat2, double lon2, bool spherical);
+
 private:
     bool spherical_; // Whether the distance calculation should be done on a sphere or 2D plane
     int numConnections_; // Stores the number of connections made in the grap
     std::unordered_map<int, GraphNode> nodes_; // Maps each airport's ID to its GraphNode
+    mutable std::shared_ptr<const CSRGraph> csr_; // The cached CSR snapshot (null until needed)
+    /**
+    * @brief Drops the cached CSR snapshot after the graph is modified
+    */
+    void _invalidate() { std::atomic_store(&csr_, std::shared_ptr<const CSRGraph>()); }
     /**
      * @brief Calculates the great circle distance between two airports using the haversine formula
      * This technically assumes the Earth is a sphere but is easier to calculate
@@ -0,0 +1,42 @@
+#include "IntegerGraph.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+IntegerGraph::IntegerGraph(const CSRGraph& csr) : fingerprint_(csr.fingerprint()), ids_(csr.getIDs()) {
+    int n = csr.size();
+    outOffsets_.resize(n + 1);
+    targets_.resize(csr.edges());
+    weights_.resize(csr.edges());
+    outOffsets_[0] = 0;
+    for (int u = 0; u < n; u++) {
+        outOffsets_[u + 1] = csr.outEnd(u);
+    }
+    for (int e = 0; e < csr.edges(); e++) {
+        targets_[e] = csr.target(e);
+        weights_[e] = toMetres(csr.weight(e));
+    }
+    weak_.resize(n);
+    strong_.resize(n);
+    for (int u = 0; u < n; u++) {
+        weak_[u] = csr.weakComponent(u);
+        strong_[u] = csr.strongComponent(u);
+    }
+}
+
+uint32_t IntegerGraph::toMetres(double kilometres) {
+    double metres = round(kilometres * 1000);
+    if (!(metres < 4294967295.0)) {
+        return 4294967295u;
+    }
+    return metres < 0 ? 0 : (uint32_t)metres;
+}
+
+int IntegerGraph::getIndex(int id) const {
+    auto it = lower_bound(ids_.begin(), ids_.end(), id);
+    if (it == ids_.end() || *it != id) {
+        return -1;
+    }
+    return it - ids_.begin();
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "CSRGraph.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief A copy of a CSRGraph's outgoing connections with distances rounded to whole metres
+ * Distances are stored as 32-bit integers instead of 64-bit doubles, which halves the weight array
+ * and lets searches use integer priority queues such as RadixHeap.
+ *
+ * Rounding error: each connection's distance is rounded to the nearest metre, so it is off by at
+ * most 0.5 m (MAX_ROUNDING_ERROR km). A path of k connections is therefore off by at most 0.5k m, and
+ * the path found with rounded distances is at most 0.5(k + k*) m longer than the true shortest path,
+ * where k and k* are the number of connections on the two paths. On a planar graph the same holds
+ * with a metre meaning a thousandth of the graph's distance unit
+ */
+class IntegerGraph {
+public:
+    /**
+    * @brief The most a connection's rounded distance differs from its true distance, in kilometres
+    */
+    static constexpr double MAX_ROUNDING_ERROR = 0.0005;
+
+    /**
+    * @brief Constructs an empty graph
+    */
+    IntegerGraph() : fingerprint_(0) {}
+    /**
+    * @brief Constructs a rounded copy of a snapshot
+    *
+    * @param csr The snapshot to copy
+    */
+    explicit IntegerGraph(const CSRGraph& csr);
+    /**
+    * @brief Constructs a rounded copy of a graph's snapshot
+    *
+    * @param g The graph to copy
+    */
+    explicit IntegerGraph(const Graph& g) : IntegerGraph(g.csr()) {}
+
+    /**
+    * @brief Rounds a distance in kilometres to whole metres
+    * Distances too long for 32 bits (over about 4 million km) are capped
+    *
+    * @param kilometres The distance
+    * @return uint32_t The distance in metres
+    */
+    static uint32_t toMetres(double kilometres);
+
+    /**
+    * @brief Gets the number of airports
+    *
+    * @return int The number of airports
+    */
+    int size() const { return ids_.size(); }
+    /**
+    * @brief Gets the number of connections
+    *
+    * @return int The number of connections
+    */
+    int edges() const { return targets_.size(); }
+    /**
+    * @brief Gets the airport ID of a dense index (the same indices as the CSRGraph)
+    *
+    * @param index The dense index (must be in range)
+    * @return int The airport's ID
+    */
+    int getID(int index) const { return ids_[index]; }
+    /**
+    * @brief Gets the dense index of an airport ID
+    *
+    * @param id The airport's ID
+    * @return int The dense index, or -1 if the airport is not in the graph
+    */
+    int getIndex(int id) const;
+    /**
+    * @brief Gets the first outgoing connection of an airport
+    *
+    * @param index The airport's dense index
+    * @return int The first edge number
+    */
+    int outBegin(int index) const { return outOffsets_[index]; }
+    /**
+    * @brief Gets one past the last outgoing connection of an airport
+    *
+    * @param index The airport's dense index
+    * @return int One past the last edge number
+    */
+    int outEnd(int index) const { return outOffsets_[index + 1]; }
+    /**
+    * @brief Gets the destination of an edge
+    *
+    * @param edge The edge number
+    * @return int The destination's dense index
+    */
+    int target(int edge) const { return targets_[edge]; }
+    /**
+    * @brief Gets the rounded distance of an edge
+    *
+    * @param edge The edge number
+    * @return uint32_t The distance in metres
+    */
+    uint32_t weight(int edge) const { return weights_[edge]; }
+
+    /**
+    * @brief Determines if the graph was copied from a snapshot
+    *
+    * @param csr The snapshot to check
+    * @return bool Whether the graph matches the snapshot
+    */
+    bool matches(const CSRGraph& csr) const { return csr.fingerprint() == fingerprint_; }
+    /**
+    * @brief Checks in O(1) whether there may be a path from one airport to another (see CSRGraph::mayReach)
+    *
+    * @param from The origin's dense index
+    * @param to The destination's dense index
+    * @return bool Whether a path is possible
+    */
+    bool mayReach(int from, int to) const { return weak_[from] == weak_[to] && strong_[from] >= strong_[to]; }
+
+private:
+    uint64_t fingerprint_; // The fingerprint of the snapshot copied
+    std::vector<int> ids_; // Maps each dense index to its airport ID (sorted)
+    std::vector<int> outOffsets_; // Where each airport's outgoing connections start (size() + 1 entries)
+    std::vector<int> targets_; // The destination of each edge
+    std::vector<uint32_t> weights_; // The distance of each edge in metres
+    std::vector<int> weak_, strong_; // Each airport's connected components, copied from the snapshot
+};
@@ -0,0 +1,97 @@
+#include "Parallel.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+int defaultThreads() {
+    return max(1, (int)thread::hardware_concurrency());
+}
+
+void parallelFor(int count, int threads, const function<void(int, int)>& body) {
+    if (threads <= 0) { threads = defaultThreads(); }
+    threads = min(threads, count);
+    if (threads <= 1) {
+        for (int i = 0; i < count; i++) { body(i, 0); }
+        return;
+    }
+    atomic<int> next(0);
+    auto worker = [&](int thread) {
+        for (int i = next++; i < count; i = next++) {
+            body(i, thread);
+        }
+    };
+    vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) {
+        workers.push_back(std::thread(worker, t));
+    }
+    worker(0);
+    for (std::thread& w : workers) { w.join(); }
+}
+
+void runTeam(int threads, const function<void(int)>& body) {
+    if (threads <= 0) { threads = defaultThreads(); }
+    vector<std::thread> team;
+    for (int t = 1; t < threads; t++) {
+        team.push_back(std::thread(body, t));
+    }
+    body(0);
+    for (std::thread& member : team) { member.join(); }
+}
+
+void Barrier::wait() {
+    unique_lock<mutex> lock(mutex_);
+    long long generation = generation_;
+    if (++waiting_ == count_) {
+        waiting_ = 0;
+        generation_++;
+        released_.notify_all();
+        return;
+    }
+    released_.wait(lock, [&] { return generation != generation_; });
+}
+
+ThreadPool::ThreadPool(int threads) : running_(0), stopping_(false) {
+    if (threads <= 0) { threads = defaultThreads(); }
+    for (int t = 0; t < threads; t++) {
+        workers_.push_back(std::thread([this] {
+            unique_lock<mutex> lock(mutex_);
+            while (true) {
+                available_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) { return; }
+                function<void()> task = std::move(tasks_.front());
+                tasks_.pop_front();
+                running_++;
+                lock.unlock();
+                task();
+                lock.lock();
+                running_--;
+                if (running_ == 0 && tasks_.empty()) { finished_.notify_all(); }
+            }
+        }));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    available_.notify_all();
+    for (std::thread& w : workers_) { w.join(); }
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    available_.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return running_ == 0 && tasks_.empty(); });
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+
+// These functions are used for spreading work over multiple threads
+
+/**
+ * @brief Gets the number of threads to use when none is requested
+ * 
+ * @return int The number of hardware threads (at least 1)
+ */
+int defaultThreads();
+
+/**
+ * @brief Calls body(i, thread) for every i from 0 to count - 1, spread over worker threads
+ * Iterations are handed out one at a time, so uneven amounts of work stay balanced.
+ * The thread argument is between 0 and the number of threads used - 1, so it can index
+ * per-thread storage. Returns once every iteration has finished
+ * 
+ * @param count The number of iterations
+ * @param threads The number of threads to use (0 to use defaultThreads())
+ * @param body The function to call for each iteration
+ */
+void parallelFor(int count, int threads, const std::function<void(int, int)>& body);
+
+/**
+ * @brief Calls body(thread) once on each of a team of threads that all run at the same time
+ * Unlike parallelFor, every thread number from 0 to threads - 1 is given its own thread, so the
+ * team can wait for each other on a Barrier for that many threads. Returns once every thread has finished
+ * 
+ * @param threads The number of threads in the team (0 to use defaultThreads())
+ * @param body The function each thread runs, given its number
+ */
+void runTeam(int threads, const std::function<void(int)>& body);
+
+/**
+ * @brief Makes a fixed number of threads wait for each other between steps of a parallel algorithm
+ * Can be reused: once every thread has called wait(), they are all released and the next call starts a new step
+ */
+class Barrier {
+public:
+    /**
+    * @brief Constructs a barrier for a number of threads
+    *
+    * @param count The number of threads that must call wait() before any of them continue
+    */
+    explicit Barrier(int count) : count_(count), waiting_(0), generation_(0) {}
+
+    /**
+    * @brief Blocks until every thread has reached the barrier
+    */
+    void wait();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable released_;
+    int count_; // the number of threads using the barrier
+    int waiting_; // the number of threads blocked in the current step
+    long long generation_; // the current step, so threads only leave once their own step is released
+};
+
+/**
+ * @brief A fixed set of worker threads that run submitted tasks in the order they were submitted
+ * Unlike parallelFor, the threads stay alive between batches of work, so a thread's own state
+ * (such as its SearchWorkspace) is reused by every task it runs
+ */
+class ThreadPool {
+public:
+    /**
+    * @brief Starts the worker threads
+    *
+    * @param threads The number of threads (0 to use defaultThreads())
+    */
+    explicit ThreadPool(int threads = 0);
+
+    /**
+    * @brief Finishes every submitted task, then stops the worker threads
+    */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+    * @brief Gets the number of worker threads
+    *
+    * @return int The number of threads
+    */
+    int size() const { return workers_.size(); }
+
+    /**
+    * @brief Queues a task to run on the next free worker thread
+    *
+    * @param task The task
+    */
+    void submit(std::function<void()> task);
+
+    /**
+    * @brief Blocks until every submitted task has finished
+    */
+    void wait();
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_; // tasks not yet started
+    std::mutex mutex_;
+    std::condition_variable available_; // signalled when a task is queued or the pool is stopping
+    std::condition_variable finished_; // signalled when the last running task finishes
+    int running_; // the number of tasks being run
+    bool stopping_;
+};
@@ -0,0 +1,37 @@
+#include "RadixHeap.h"
+
+using namespace std;
+
+void RadixHeap::clear() {
+    for (auto& bucket : buckets_) {
+        bucket.clear();
+    }
+    size_ = 0;
+    last_ = 0;
+}
+
+pair<uint64_t, int> RadixHeap::pop() {
+    if (buckets_[0].empty()) {
+        // the smallest key is in the first non-empty bucket; making it the last key popped spreads
+        // that bucket's items over lower buckets, at least one of them into bucket 0
+        size_t i = 1;
+        while (buckets_[i].empty()) {
+            i++;
+        }
+        uint64_t smallest = buckets_[i][0].first;
+        for (auto& item : buckets_[i]) {
+            if (item.first < smallest) {
+                smallest = item.first;
+            }
+        }
+        last_ = smallest;
+        for (auto& item : buckets_[i]) {
+            buckets_[bucketOf(item.first)].push_back(item);
+        }
+        buckets_[i].clear();
+    }
+    pair<uint64_t, int> item = buckets_[0].back();
+    buckets_[0].pop_back();
+    size_--;
+    return item;
+}
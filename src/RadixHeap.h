@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief A radix heap of airports keyed by integer distances
+ * Only works for monotone priorities, as in Dijkstra's algorithm: every key pushed must be at least
+ * the last key popped. Items are kept in buckets by the highest bit in which their key differs from
+ * the last key popped, so pushing is O(1) and each item is moved to a lower bucket at most 64 times
+ * over its life, instead of the O(log n) comparisons per operation of a binary heap
+ */
+class RadixHeap {
+public:
+    /**
+    * @brief Constructs an empty heap
+    */
+    RadixHeap() : buckets_(65), size_(0), last_(0) {}
+
+    /**
+    * @brief Empties the heap, keeping its memory for reuse
+    */
+    void clear();
+
+    /**
+    * @brief Gets whether the heap is empty
+    *
+    * @return bool Whether there are no items
+    */
+    bool empty() const { return size_ == 0; }
+    /**
+    * @brief Gets the number of items in the heap
+    *
+    * @return size_t The number of items
+    */
+    std::size_t size() const { return size_; }
+
+    /**
+    * @brief Adds an item
+    *
+    * @param key The item's key (must be at least the last key popped)
+    * @param value The item
+    */
+    void push(uint64_t key, int value) {
+        buckets_[bucketOf(key)].push_back(std::make_pair(key, value));
+        size_++;
+    }
+
+    /**
+    * @brief Removes an item with the smallest key (the heap must not be empty)
+    *
+    * @return pair<uint64_t, int> The key and the item
+    */
+    std::pair<uint64_t, int> pop();
+
+private:
+    /**
+    * @brief Gets the bucket a key belongs in, relative to the last key popped
+    *
+    * @param key The key
+    * @return int 0 if the key equals the last key popped, otherwise 1 + the highest differing bit
+    */
+    int bucketOf(uint64_t key) const { return key == last_ ? 0 : 64 - __builtin_clzll(key ^ last_); }
+
+    std::vector<std::vector<std::pair<uint64_t, int>>> buckets_; // bucket 0 holds keys equal to last_
+    std::size_t size_; // the number of items in every bucket
+    uint64_t last_; // the last key popped
+};
@@ -0,0 +1,38 @@
+#include "SearchMask.h"
+#include <algorithm>
+
+using namespace std;
+
+void SearchMask::clear(int nodes, int edges) {
+    generation_++;
+    if (generation_ == 0) {
+        // the stamps wrapped around, so old bans could match again
+        fill(nodes_.begin(), nodes_.end(), 0);
+        fill(edges_.begin(), edges_.end(), 0);
+        generation_ = 1;
+    }
+    if ((int)nodes_.size() < nodes) { nodes_.resize(nodes, 0); }
+    if ((int)edges_.size() < edges) { edges_.resize(edges, 0); }
+}
+
+bool SearchMask::banAirport(const CSRGraph& csr, int id) {
+    _fit(csr);
+    int v = csr.getIndex(id);
+    if (v == -1) { return false; }
+    banNode(v);
+    return true;
+}
+
+bool SearchMask::banRoute(const CSRGraph& csr, int from, int to) {
+    _fit(csr);
+    int u = csr.getIndex(from), v = csr.getIndex(to);
+    int edge = u == -1 || v == -1 ? -1 : csr.findEdge(u, v);
+    if (edge == -1) { return false; }
+    banEdge(edge);
+    return true;
+}
+
+void SearchMask::_fit(const CSRGraph& csr) {
+    if ((int)nodes_.size() < csr.size()) { nodes_.resize(csr.size(), 0); }
+    if ((int)edges_.size() < csr.edges()) { edges_.resize(csr.edges(), 0); }
+}
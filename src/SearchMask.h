@@ -0,0 +1,96 @@
+#pragma once
+#include "CSRGraph.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief A set of banned airports and connections that searches skip, by CSRGraph dense index and edge number
+ * Lets a search run on what is left of a graph without copying or modifying the Graph. Like
+ * SearchWorkspace, bans are stamped with a generation, so clear() lifts every ban in O(1).
+ * A mask belongs to one snapshot: if the Graph changes, clear it and ban again. Banning grows the mask as
+ * needed, so a mask that was never cleared bans safely too
+ */
+class SearchMask {
+public:
+    /**
+    * @brief Constructs a mask that bans nothing
+    */
+    SearchMask() : generation_(1) {}
+
+    /**
+    * @brief Lifts every ban and makes room for a graph's airports and connections
+    *
+    * @param nodes The number of airports in the graph
+    * @param edges The number of connections in the graph
+    */
+    void clear(int nodes, int edges);
+    /**
+    * @brief Lifts every ban and makes room for a snapshot's airports and connections
+    *
+    * @param csr The snapshot the bans will refer to
+    */
+    void clear(const CSRGraph& csr) { clear(csr.size(), csr.edges()); }
+
+    /**
+    * @brief Bans an airport by ID, such as a closed airport
+    *
+    * @param csr The snapshot the bans refer to (room is made for it if the mask was never cleared)
+    * @param id The airport's ID
+    * @return bool Whether the airport was found
+    */
+    bool banAirport(const CSRGraph& csr, int id);
+    /**
+    * @brief Bans the connection from one airport to another by ID (does not go both ways)
+    *
+    * @param csr The snapshot the bans refer to (room is made for it if the mask was never cleared)
+    * @param from The ID of the starting airport
+    * @param to The ID of the ending airport
+    * @return bool Whether the connection was found
+    */
+    bool banRoute(const CSRGraph& csr, int from, int to);
+
+    /**
+    * @brief Bans an airport, making room for it if the mask was cleared for a smaller graph
+    *
+    * @param v The airport's dense index
+    */
+    void banNode(int v) {
+        if (v >= (int)nodes_.size()) { nodes_.resize(v + 1, 0); }
+        nodes_[v] = generation_;
+    }
+    /**
+    * @brief Bans a connection, making room for it if the mask was cleared for a smaller graph
+    *
+    * @param edge The connection's edge number
+    */
+    void banEdge(int edge) {
+        if (edge >= (int)edges_.size()) { edges_.resize(edge + 1, 0); }
+        edges_[edge] = generation_;
+    }
+
+    /**
+    * @brief Determines if an airport is banned
+    *
+    * @param v The airport's dense index
+    * @return bool Whether the airport is banned
+    */
+    bool nodeBanned(int v) const { return v < (int)nodes_.size() && nodes_[v] == generation_; }
+    /**
+    * @brief Determines if a connection is banned
+    *
+    * @param edge The connection's edge number
+    * @return bool Whether the connection is banned
+    */
+    bool edgeBanned(int edge) const { return edge < (int)edges_.size() && edges_[edge] == generation_; }
+
+private:
+    /**
+    * @brief Makes room for a snapshot's airports and connections, keeping every ban
+    *
+    * @param csr The snapshot
+    */
+    void _fit(const CSRGraph& csr);
+
+    uint32_t generation_; // bans stamped with any other value have been lifted
+    std::vector<uint32_t> nodes_, edges_; // the generation each airport and connection was last banned in
+};
@@ -0,0 +1,44 @@
+#include "SearchWorkspace.h"
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+static atomic<long long> allocations_(0);
+
+SearchWorkspace& SearchWorkspace::local() {
+    thread_local SearchWorkspace workspace;
+    return workspace;
+}
+
+long long SearchWorkspace::allocations() {
+    return allocations_.load();
+}
+
+void SearchWorkspace::reset(int size) {
+    // the queue buffers grow while searching, so growth is noticed at the next reset
+    if (heap_.capacity() > heapCapacity_ || queue_.capacity() > queueCapacity_) {
+        allocations_++;
+        heapCapacity_ = heap_.capacity();
+        queueCapacity_ = queue_.capacity();
+    }
+    heap_.clear();
+    queue_.clear();
+    radixHeap_.clear();
+
+    if ((int)reached_.size() < size) {
+        allocations_++;
+        reached_.assign(size, 0);
+        visited_.assign(size, 0);
+        distances_.resize(size);
+        parents_.resize(size);
+        generation_ = 0;
+    }
+    generation_++;
+    if (generation_ == 0) {
+        // the stamps wrapped around, so old stamps could match again
+        fill(reached_.begin(), reached_.end(), 0);
+        fill(visited_.begin(), visited_.end(), 0);
+        generation_ = 1;
+    }
+}
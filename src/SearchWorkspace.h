@@ -0,0 +1,125 @@
+#pragma once
+#include "RadixHeap.h"
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <limits>
+#include <cstddef>
+
+/**
+ * @brief Reusable per-airport state for graph searches over a CSRGraph's dense indices
+ * Holds flat distance, parent and visited arrays plus queue buffers. Instead of clearing the
+ * arrays between searches, every entry carries the generation it was written in, and reset()
+ * just starts a new generation, so entries from earlier searches read as unset in O(1).
+ * Once the arrays have grown to the graph's size, searches allocate no memory at all.
+ *
+ * Each thread has its own workspace (see local()); a thread should only run one search in it at a time
+ */
+class SearchWorkspace {
+public:
+    /**
+    * @brief Constructs an empty workspace
+    */
+    SearchWorkspace() : generation_(0), heapCapacity_(0), queueCapacity_(0) {}
+
+    /**
+    * @brief Gets the calling thread's workspace, creating it on the thread's first call
+    *
+    * @return SearchWorkspace& The thread's workspace
+    */
+    static SearchWorkspace& local();
+
+    /**
+    * @brief Gets the number of times any workspace has had to allocate memory
+    * Stops increasing once every thread's workspace has grown to fit the graphs it searches
+    *
+    * @return long long The number of allocations
+    */
+    static long long allocations();
+
+    /**
+    * @brief Starts a new search, making every airport unset and unvisited and emptying the queues
+    *
+    * @param size The number of airports in the graph to be searched
+    */
+    void reset(int size);
+
+    /**
+    * @brief Determines if an airport has been given a distance in the current search
+    *
+    * @param v The airport's dense index
+    * @return bool Whether the airport has been reached
+    */
+    bool reached(int v) const { return reached_[v] == generation_; }
+    /**
+    * @brief Gets an airport's distance in the current search
+    *
+    * @param v The airport's dense index
+    * @return double The distance, or infinity if the airport has not been reached
+    */
+    double distance(int v) const { return reached(v) ? distances_[v] : std::numeric_limits<double>::infinity(); }
+    /**
+    * @brief Gets an airport's parent in the current search
+    *
+    * @param v The airport's dense index
+    * @return int The parent's dense index, or -1 if the airport has none
+    */
+    int parent(int v) const { return reached(v) ? parents_[v] : -1; }
+    /**
+    * @brief Sets an airport's distance and parent in the current search
+    *
+    * @param v The airport's dense index
+    * @param distance The distance
+    * @param parent The parent's dense index (-1 for none)
+    */
+    void reach(int v, double distance, int parent) {
+        reached_[v] = generation_;
+        distances_[v] = distance;
+        parents_[v] = parent;
+    }
+
+    /**
+    * @brief Determines if an airport has been visited (settled) in the current search
+    *
+    * @param v The airport's dense index
+    * @return bool Whether the airport has been visited
+    */
+    bool visited(int v) const { return visited_[v] == generation_; }
+    /**
+    * @brief Marks an airport as visited in the current search
+    *
+    * @param v The airport's dense index
+    */
+    void visit(int v) { visited_[v] = generation_; }
+
+    /**
+    * @brief Gets the buffer for a binary heap of (distance, airport) pairs
+    * Use it with push_heap and pop_heap and greater<>, so the smallest distance is at the front
+    *
+    * @return vector<pair<double, int>>& The heap, empty after reset()
+    */
+    std::vector<std::pair<double, int>>& heap() { return heap_; }
+    /**
+    * @brief Gets the buffer for a first-in first-out queue of airports
+    * Use it by appending airports and reading them with a separate front index
+    *
+    * @return vector<int>& The queue, empty after reset()
+    */
+    std::vector<int>& queue() { return queue_; }
+    /**
+    * @brief Gets the radix heap for searches with integer distances
+    *
+    * @return RadixHeap& The heap, empty after reset()
+    */
+    RadixHeap& radixHeap() { return radixHeap_; }
+
+private:
+    uint32_t generation_; // the current search; entries stamped with any other value are unset
+    std::vector<uint32_t> reached_, visited_; // the generation each airport was last reached and visited in
+    std::vector<double> distances_;
+    std::vector<int> parents_;
+    std::vector<std::pair<double, int>> heap_;
+    std::vector<int> queue_;
+    RadixHeap radixHeap_;
+    std::size_t heapCapacity_, queueCapacity_; // the queue buffers' capacities at the last reset, to notice growth
+};
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <random>
 #include <map>
+#include <cmath>
+#include <algorithm>
 
 using namespace std;
 
@@ -248,3 +250,87 @@ Graph sampleData(string vertexFile, string edgeFile, int sampleSize) {
 
     return g;
 }
+
+Graph syntheticData(int numAirports, int routesPerAirport, unsigned seed) {
+    Graph g;
+    if (numAirports <= 0) {
+        return g;
+    }
+    mt19937 generator(seed);
+    uniform_real_distribution<double> uniform(0, 1);
+    double PI = 4*atan(1);
+
+    // airports are bucketed into cells so nearby ones can be found without comparing every pair
+    const int CELL_DEGREES = 2, HUB_CELL_DEGREES = 10;
+    auto cellOf = [](double lat, double lon, int degrees) {
+        int row = min((int)((lat + 90) / degrees), 180 / degrees - 1);
+        int col = min((int)((lon + 180) / degrees), 360 / degrees - 1);
+        return make_pair(row, col);
+    };
+    map<pair<int, int>, vector<int>> cells, hubCells;
+    int numHubs = max(1, numAirports / 50);
+    vector<pair<double, double>> coords(numAirports + 1);
+    for (int id = 1; id <= numAirports; id++) {
+        // uniform over the sphere rather than over latitude
+        double lat = asin(2 * uniform(generator) - 1) * 180 / PI;
+        double lon = uniform(generator) * 360 - 180;
+        coords[id] = make_pair(lat, lon);
+        g.addNode(id, "Synthetic Airport " + to_string(id), lat, lon);
+        cells[cellOf(lat, lon, CELL_DEGREES)].push_back(id);
+        if (id <= numHubs) {
+            hubCells[cellOf(lat, lon, HUB_CELL_DEGREES)].push_back(id);
+        }
+    }
+
+    // picks a random airport from a cell or its neighbors, or -1 if there are none
+    auto nearby = [&](map<pair<int, int>, vector<int>> & grid, pair<int, int> cell) {
+        vector<const vector<int>*> choices;
+        int total = 0;
+        for (int dr = -1; dr <= 1; dr++) {
+            for (int dc = -1; dc <= 1; dc++) {
+                auto it = grid.find(make_pair(cell.first + dr, cell.second + dc));
+                if (it != grid.end()) {
+                    choices.push_back(&it->second);
+                    total += it->second.size();
+                }
+            }
+        }
+        if (total == 0) {
+            return -1;
+        }
+        int index = uniform_int_distribution<int>(0, total - 1)(generator);
+        for (const vector<int>* choice : choices) {
+            if (index < (int)choice->size()) {
+                return (*choice)[index];
+            }
+            index -= choice->size();
+        }
+        return -1;
+    };
+    auto connectBoth = [&](int id1, int id2) {
+        if (id1 != id2 && !g.connectedTo(id1, id2)) {
+            g.connect(id1, id2);
+            g.connect(id2, id1);
+        }
+    };
+
+    uniform_int_distribution<int> anyHub(1, numHubs);
+    for (int id = 1; id <= numAirports; id++) {
+        double lat = coords[id].first, lon = coords[id].second;
+        for (int r = 0; r < routesPerAirport; r++) {
+            int other = nearby(cells, cellOf(lat, lon, CELL_DEGREES));
+            if (other != -1) {
+                connectBoth(id, other);
+            }
+        }
+        int hub = nearby(hubCells, cellOf(lat, lon, HUB_CELL_DEGREES));
+        connectBoth(id, hub == -1 ? anyHub(generator) : hub);
+    }
+    // long-haul routes between hubs
+    for (int hub = 1; hub <= numHubs; hub++) {
+        for (int r = 0; r < routesPerAirport; r++) {
+            connectBoth(hub, anyHub(generator));
+        }
+    }
+    return g;
+}
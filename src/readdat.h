@@ -70,3 +70,16 @@ Graph readData(std::string vertexFile, std::string edgeFile, std::vector<int> id
 * @return Graph A graph of the data
 */
 Graph sampleData(std::string vertexFile, std::string edgeFile, int sampleSize);
+
+/**
+* @brief Generates a random airport network with hub structure, for testing at larger scales
+* Airports are scattered uniformly over the globe. Each airport has routes to and from some
+* nearby airports and to and from a nearby hub, and the hubs are linked to each other
+* IDs are 1 to numAirports, and the same seed always gives the same network
+*
+* @param numAirports The number of airports
+* @param routesPerAirport The number of round-trip routes each airport adds to nearby airports
+* @param seed The random seed
+* @return Graph A graph of the generated network
+*/
+Graph syntheticData(int numAirports, int routesPerAirport = 3, unsigned seed = 1);
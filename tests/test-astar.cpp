@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Algorithms/astar.h"
+#include "Algorithms/dijkstra.h"
+
+using namespace std;
+
+TEST_CASE("Simple A*") {
+
+    /*
+            |2| ----- |3|
+          /            |
+        /              |
+    |1|                | 
+        \              | 
+         \             |
+          |4| ------- |5|
+                       |
+                      |6|  
+    */
+
+    Graph g;
+
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 1, 1);
+    g.addNode(3, "three", 2, 1);
+    g.addNode(4, "four", 1, -1);
+    g.addNode(5, "five", 2, -1);
+    g.addNode(6, "six", 2, -2);
+
+    g.connect(1, 2);
+    g.connect(1, 4);
+    g.connect(2, 4);
+    g.connect(2, 3);
+    g.connect(4, 5);
+    g.connect(3, 5);
+    g.connect(5, 6);
+
+    AStar astar;
+    vector<int> expected = {1, 4, 5, 6};
+    REQUIRE(astar.getPath(g, 1, 6) == expected);
+
+    Dijkstras dij;
+    dij.getPath(g, 1, 6);
+    REQUIRE(astar.shortestDistance() == dij.shortestDistance());
+
+    REQUIRE(astar.getPath(g, 6, 1) == vector<int>());
+    REQUIRE(astar.shortestDistance() == numeric_limits<double>::infinity());
+    REQUIRE(astar.getPath(g, 3, 3) == vector<int>(1, 3));
+    REQUIRE(astar.shortestDistance() == 0);
+    REQUIRE(astar.getPath(g, 1, 42) == vector<int>());
+}
+
+TEST_CASE("A* With Landmarks Matches Dijkstra") {
+    Graph g = readData("../Data/airports.dat",  "../Data/routes.dat");
+
+    Landmarks farthest, avoid;
+    farthest.build(g, 8, Landmarks::FARTHEST, 2);
+    avoid.build(g, 8, Landmarks::AVOID, 2);
+    REQUIRE(farthest.count() == 8);
+    REQUIRE(avoid.count() == 8);
+
+    vector<pair<int, int>> queries = {{4049, 3077}, {5438, 5695}, {3830, 4105}, {3077, 4049}, {1, 3830}};
+    for (auto query : queries) {
+        Dijkstras dij;
+        vector<int> expected = dij.getPath(g, query.first, query.second);
+
+        AStar geometric;
+        AStar alt(farthest);
+        AStar altAvoid(avoid, 0);
+        vector<int> geometricPath = geometric.getPath(g, query.first, query.second);
+        vector<int> altPath = alt.getPath(g, query.first, query.second);
+        vector<int> avoidPath = altAvoid.getPath(g, query.first, query.second);
+
+        REQUIRE(abs(geometric.shortestDistance() - dij.shortestDistance()) < 1e-6);
+        REQUIRE(abs(alt.shortestDistance() - dij.shortestDistance()) < 1e-6);
+        REQUIRE(abs(altAvoid.shortestDistance() - dij.shortestDistance()) < 1e-6);
+        REQUIRE(altPath.size() == expected.size());
+        REQUIRE(avoidPath.size() == expected.size());
+
+        const CSRGraph& csr = g.csr();
+        int s = csr.getIndex(query.first), t = csr.getIndex(query.second);
+        REQUIRE(farthest.lowerBound(s, t) <= dij.shortestDistance() + 1e-6);
+        REQUIRE(avoid.lowerBound(s, t) <= dij.shortestDistance() + 1e-6);
+    }
+}
+
+TEST_CASE("Landmarks Save and Load") {
+    Graph g = readData("../Data/airports.dat",  "../Data/routes.dat");
+    Landmarks built;
+    built.build(g, 4);
+    REQUIRE(built.save("landmarks_test.alt"));
+
+    Landmarks loaded;
+    REQUIRE(loaded.load("landmarks_test.alt", g));
+    REQUIRE(loaded.getLandmarkIDs() == built.getLandmarkIDs());
+    const CSRGraph& csr = g.csr();
+    int s = csr.getIndex(4049), t = csr.getIndex(3077);
+    REQUIRE(loaded.lowerBound(s, t) == built.lowerBound(s, t));
+
+    // tables from a different graph are rejected
+    g.connect(26, 41);
+    Landmarks rejected;
+    REQUIRE(!rejected.load("landmarks_test.alt", g));
+    REQUIRE(!built.matches(g.csr()));
+    remove("landmarks_test.alt");
+}
+
+TEST_CASE("Landmarks Reject Corrupt Files") {
+    Graph g = readData("../Data/airports.dat",  "../Data/routes.dat");
+    Landmarks built;
+    built.build(g, 4);
+    REQUIRE(built.save("landmarks_test.alt"));
+    ifstream in("landmarks_test.alt", ios::binary);
+    string bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    size_t n = g.csr().size(), k = 4;
+    size_t header = bytes.size() - 2 * k * sizeof(int) - 2 * n * k * sizeof(double) - 2 * sizeof(int32_t);
+
+    // writes a patched copy of the tables and tries to load it
+    auto loads = [&](size_t offset, int32_t value, size_t length) {
+        string patched = bytes.substr(0, length);
+        if (offset + sizeof(value) <= patched.size()) { memcpy(&patched[offset], &value, sizeof(value)); }
+        ofstream out("landmarks_corrupt.alt", ios::binary);
+        out.write(patched.data(), patched.size());
+        out.close();
+        Landmarks loaded;
+        return loaded.load("landmarks_corrupt.alt", g);
+    };
+    size_t whole = bytes.size(), firstLandmark = header + 2 * sizeof(int32_t);
+    REQUIRE(loads(0, 0, whole) == false);  // bad magic
+    REQUIRE(loads(header + sizeof(int32_t), 1 << 30, whole) == false);  // far more landmarks than airports
+    REQUIRE(loads(header + sizeof(int32_t), 3, whole) == false);  // count disagrees with the file length
+    REQUIRE(loads(firstLandmark, (int32_t)n, whole) == false);  // landmark index out of range
+    REQUIRE(loads(firstLandmark, -1, whole) == false);
+    REQUIRE(loads(firstLandmark + k * sizeof(int), 0, whole) == false);  // landmark ID does not match its index
+    REQUIRE(loads(whole, 0, whole - 1) == false);  // truncated
+    REQUIRE(loads(whole, 0, whole) == true);
+    remove("landmarks_test.alt");
+    remove("landmarks_corrupt.alt");
+}
+
+TEST_CASE("A* Avoiding Airports Matches Dijkstra") {
+    Graph g = readData("../Data/airports.dat",  "../Data/routes.dat");
+    const CSRGraph& csr = g.csr();
+    Landmarks landmarks;
+    landmarks.build(g, 8, Landmarks::FARTHEST, 2);
+
+    // closes the busiest airports on the test routes
+    SearchMask mask;
+    mask.clear(csr);
+    for (int id : {3830, 3797, 340, 507}) { REQUIRE(mask.banAirport(csr, id)); }
+
+    vector<pair<int, int>> queries = {{4049, 3077}, {5438, 5695}, {3830, 4105}, {3077, 4049}, {1, 2279}};
+    for (auto query : queries) {
+        Dijkstras dij;
+        vector<int> expected = dij.getPath(g, query.first, query.second, &mask);
+        AStar geometric;
+        AStar alt(landmarks);
+        REQUIRE(geometric.getPath(g, query.first, query.second, &mask).size() == expected.size());
+        REQUIRE(alt.getPath(g, query.first, query.second, &mask).size() == expected.size());
+        if (expected.empty()) {
+            REQUIRE(geometric.shortestDistance() == numeric_limits<double>::infinity());
+            REQUIRE(alt.shortestDistance() == numeric_limits<double>::infinity());
+            continue;
+        }
+        REQUIRE(abs(geometric.shortestDistance() - dij.shortestDistance()) < 1e-6);
+        REQUIRE(abs(alt.shortestDistance() - dij.shortestDistance()) < 1e-6);
+        for (int id : expected) { REQUIRE(!mask.nodeBanned(csr.getIndex(id))); }
+    }
+}
+
+TEST_CASE("A* After Switching To Spherical Distances") {
+    // built with planar distances in degrees, then switched, so the routes must be remeasured in kilometres
+    Graph g(false);
+    for (int i = 1; i <= 30; i++) { g.addNode(i, "air", (i * 37) % 60 - 30, (i * 53) % 120 - 60); }
+    for (int i = 1; i <= 30; i++) {
+        g.connect(i, i % 30 + 1);
+        g.connect(i, (i * 7) % 30 + 1);
+    }
+    g.setSpherical(true);
+    REQUIRE(g.getDistance(1, 2) == Graph::coordinateDistance(g.getLatitude(1), g.getLongitude(1),
+        g.getLatitude(2), g.getLongitude(2), true));
+
+    AStar astar;
+    Dijkstras dij;
+    for (int from = 1; from <= 30; from++) {
+        for (int to = 1; to <= 30; to += 7) {
+            vector<int> expected = dij.getPath(g, from, to);
+            REQUIRE(astar.getPath(g, from, to) == expected);
+            REQUIRE(astar.shortestDistance() == dij.shortestDistance());
+        }
+    }
+}
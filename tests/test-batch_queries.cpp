@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Parallel.h"
+#include "Algorithms/batch_queries.h"
+#include "Algorithms/dijkstra.h"
+
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <limits>
+#include <cstring>
+
+using namespace std;
+
+TEST_CASE("Thread Pool Runs Every Task") {
+    atomic<int> total(0);
+    ThreadPool pool(3);
+    REQUIRE(pool.size() == 3);
+    for (int i = 1; i <= 100; i++) {
+        pool.submit([&total, i] { total += i; });
+    }
+    pool.wait();
+    REQUIRE(total == 5050);
+    pool.submit([&total] { total = 0; });
+    pool.wait();
+    REQUIRE(total == 0);
+}
+
+TEST_CASE("Batch Matches Dijkstra") {
+    Graph g = syntheticData(500);
+    vector<int> ids = g.getIDs();
+    vector<pair<int, int>> queries;
+    // few sources, so most groups hold many queries
+    for (int i = 0; i < 1000; i++) {
+        queries.push_back(make_pair(ids[(i * 7) % 40], ids[(i * 31 + 5) % ids.size()]));
+    }
+    queries.push_back(make_pair(-5, ids[0]));
+    queries.push_back(make_pair(ids[0], -5));
+
+    vector<RouteResult> results(queries.size());
+    vector<bool> seen(queries.size(), false);
+    BatchSummary summary = routeBatch(g, queries, 4, [&](const vector<RouteResult>& group) {
+        for (const RouteResult& result : group) {
+            REQUIRE_FALSE(seen[result.query]);
+            seen[result.query] = true;
+            results[result.query] = result;
+        }
+    });
+    REQUIRE(summary.queries == (long long)queries.size());
+    REQUIRE(summary.sources == 41);
+
+    Dijkstras dij;
+    long long unreachable = 0;
+    for (size_t i = 0; i < queries.size(); i++) {
+        REQUIRE(seen[i]);
+        REQUIRE(results[i].source == queries[i].first);
+        REQUIRE(results[i].target == queries[i].second);
+        vector<int> expected = dij.getPath(g, queries[i].first, queries[i].second);
+        REQUIRE(results[i].path == expected);
+        REQUIRE(results[i].distance == dij.shortestDistance());
+        unreachable += expected.empty();
+    }
+    REQUIRE(summary.unreachable == unreachable);
+}
+
+TEST_CASE("Batch Files") {
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 0, 3);
+    g.connect(1, 2);
+    g.connect(2, 3);
+
+    ofstream queryFile("batch_queries_test.csv");
+    queryFile << "source,target\n1,3\n3 1\n\n2,2\n";
+    queryFile.close();
+    vector<pair<int, int>> queries;
+    REQUIRE(readQueries("batch_queries_test.csv", queries));
+    REQUIRE(queries == vector<pair<int, int>>({{1, 3}, {3, 1}, {2, 2}}));
+    REQUIRE_FALSE(readQueries("missing_batch_queries.csv", queries));
+
+    BatchSummary summary;
+    REQUIRE(runBatch(g, queries, "batch_results_test.csv", false, 2, &summary));
+    REQUIRE(summary.unreachable == 1);
+    ifstream csv("batch_results_test.csv");
+    vector<string> lines;
+    string line;
+    while (getline(csv, line)) { lines.push_back(line); }
+    REQUIRE(lines.size() == 4);
+    REQUIRE(lines[0] == "query,source,target,distance,hops,path");
+    sort(lines.begin() + 1, lines.end());
+    REQUIRE(lines[1] == "0,1,3,3,2,1 2 3");
+    REQUIRE(lines[2] == "1,3,1,inf,-1,");
+    REQUIRE(lines[3] == "2,2,2,0,0,2");
+
+    REQUIRE(runBatch(g, queries, "batch_results_test.bin", true, 2));
+    ifstream bin("batch_results_test.bin", ios::binary);
+    char magic[8];
+    bin.read(magic, 8);
+    REQUIRE(memcmp(magic, "ROUTES01", 8) == 0);
+    int records = 0;
+    int32_t fields[3], hops;
+    double distance;
+    while (bin.read((char*)fields, sizeof(fields))) {
+        bin.read((char*)&distance, sizeof(distance));
+        bin.read((char*)&hops, sizeof(hops));
+        vector<int32_t> path(hops + 1);
+        bin.read((char*)path.data(), path.size() * sizeof(int32_t));
+        if (fields[0] == 0) {
+            REQUIRE(distance == 3);
+            REQUIRE(path == vector<int32_t>({1, 2, 3}));
+        } else if (fields[0] == 1) {
+            REQUIRE(distance == numeric_limits<double>::infinity());
+            REQUIRE(hops == -1);
+        }
+        records++;
+    }
+    REQUIRE(records == 3);
+}
@@ -3,6 +3,9 @@
 #include "readdat.h"
 
 #include <iostream>
+#include <random>
+#include <limits>
+#include <cmath>
 
 #include "Algorithms/bet_cent.h"
 
@@ -316,3 +319,523 @@ TEST_CASE ("Betweeness Centrality Probabilistic (Skip non-Paths False) ") {
 
     set<int> probabilistic_set = betcent.getAirportsWithMinFrequency(2);
 }
+
+/**
+* @brief Computes single-path scores the original way, one Dijkstras::getPath per ordered pair
+*
+* @param g The graph
+* @return map<int, int> Every airport's number of appearances inside the paths
+*/
+static map<int, int> pairwiseScores(const Graph& g) {
+    map<int, int> scores;
+    Dijkstras d;
+    for (int source : g.getIDs()) {
+        scores[source] += 0;
+        for (int target : g.getIDs()) {
+            vector<int> path = d.getPath(g, source, target);
+            for (size_t i = 1; i + 1 < path.size(); i++) { scores[path[i]]++; }
+        }
+    }
+    return scores;
+}
+
+/**
+* @brief Builds a random graph of mostly one-way routes
+*
+* @param rng The random generator
+* @param spherical Whether the coordinates are on a sphere
+* @param grid Whether airports are kept to a small grid and connected along its lines, so many distances tie
+* @return Graph The graph
+*/
+static Graph randomGraph(mt19937& rng, bool spherical, bool grid) {
+    Graph g(spherical);
+    int n = 2 + rng() % 25;
+    // distinct points of a 6 by 6 grid, since airports in the same place would be joined by zero distances
+    vector<int> cells(36);
+    for (int i = 0; i < 36; i++) { cells[i] = i; }
+    shuffle(cells.begin(), cells.end(), rng);
+    for (int i = 1; i <= n; i++) {
+        double x = grid ? cells[i] / 6 : (rng() % 10000) / 100.0;
+        double y = grid ? cells[i] % 6 : (rng() % 10000) / 100.0;
+        g.addNode(i * 5, "air", x, y);
+    }
+    int routes = rng() % (4 * n);
+    for (int i = 0; i < routes; i++) {
+        int from = 1 + rng() % n, to = 1 + rng() % n;
+        // on the grid, only along rows and columns, so every distance and sum of distances is a whole number
+        if (grid && cells[from] / 6 != cells[to] / 6 && cells[from] % 6 != cells[to] % 6) { continue; }
+        from *= 5;
+        to *= 5;
+        g.connect(from, to);
+        if (rng() % 2 == 0) { g.connect(to, from); }
+    }
+    return g;
+}
+
+/**
+* @brief Computes exact betweenness by brute force: for every pair, the share of its shortest paths through each airport
+*
+* @param g The graph
+* @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+* @return map<int, double> Every airport's score
+*/
+static map<int, double> bruteForceScores(const Graph& g, bool weighted) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    double inf = numeric_limits<double>::infinity();
+    // all-pairs distances and path counts by relaxing in distance order from each source (tiny graphs only)
+    vector<vector<double>> dist(n, vector<double>(n, inf)), paths(n, vector<double>(n, 0));
+    for (int s = 0; s < n; s++) {
+        dist[s][s] = 0;
+        for (int round = 0; round < n; round++) {
+            for (int u = 0; u < n; u++) {
+                for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+                    double alt = dist[s][u] + (weighted ? csr.weight(e) : 1);
+                    if (alt < dist[s][csr.target(e)]) { dist[s][csr.target(e)] = alt; }
+                }
+            }
+        }
+    }
+    // paths[s][t] counts shortest paths by the last leg, taking targets in order of distance
+    for (int s = 0; s < n; s++) {
+        vector<int> byDistance;
+        for (int t = 0; t < n; t++) { if (dist[s][t] != inf) { byDistance.push_back(t); } }
+        sort(byDistance.begin(), byDistance.end(), [&](int a, int b) { return dist[s][a] < dist[s][b]; });
+        paths[s][s] = 1;
+        for (int t : byDistance) {
+            if (t == s) { continue; }
+            for (int i = csr.inBegin(t); i < csr.inEnd(t); i++) {
+                int u = csr.source(i);
+                if (dist[s][u] + (weighted ? csr.weight(csr.inEdge(i)) : 1) == dist[s][t]) {
+                    paths[s][t] += paths[s][u];
+                }
+            }
+        }
+    }
+    map<int, double> scores;
+    for (int v = 0; v < n; v++) {
+        double score = 0;
+        for (int s = 0; s < n; s++) {
+            for (int t = 0; t < n; t++) {
+                if (s == v || t == v || s == t || dist[s][t] == inf) { continue; }
+                // the sums are taken in a different order than along the paths, so they may differ by rounding
+                if (abs(dist[s][v] + dist[v][t] - dist[s][t]) < 1e-9) {
+                    score += paths[s][v] * paths[v][t] / paths[s][t];
+                }
+            }
+        }
+        scores[csr.getID(v)] = score;
+    }
+    return scores;
+}
+
+TEST_CASE("Brandes Single Path Matches Pairwise Dijkstra") {
+    mt19937 rng(45);
+    vector<Graph> graphs;
+    for (int i = 0; i < 20; i++) { graphs.push_back(randomGraph(rng, true, false)); }
+    graphs.push_back(syntheticData(150));
+    for (const Graph& g : graphs) {
+        map<int, int> expected = pairwiseScores(g);
+        BetweenessCentrality betcent;
+        REQUIRE(betcent.getAllScores(g, false, false) == expected);
+        map<int, double> brandes = betcent.getBrandesScores(g, true, true);
+        REQUIRE(brandes.size() == expected.size());
+        for (auto score : brandes) { REQUIRE(score.second == expected[score.first]); }
+    }
+}
+
+TEST_CASE("Brandes Splits Credit Among Shortest Paths") {
+
+    /*
+
+              |2|
+             /   \
+          |1|     |4|
+             \   /
+              |3|
+
+    */
+
+    Graph g(false);
+    g.addNode(1, "air1", 0, 0);
+    g.addNode(2, "air2", 1, 1);
+    g.addNode(3, "air3", 1, -1);
+    g.addNode(4, "air4", 2, 0);
+    g.connect(1,2);
+    g.connect(2,1);
+    g.connect(1,3);
+    g.connect(3,1);
+    g.connect(2,4);
+    g.connect(4,2);
+    g.connect(3,4);
+    g.connect(4,3);
+
+    BetweenessCentrality betcent;
+    // 1 -> 4 and 4 -> 1 each have two shortest paths, and 2 -> 3 and 3 -> 2 have four
+    map<int, double> scores = betcent.getBrandesScores(g);
+    REQUIRE(scores[1] == 1);
+    REQUIRE(scores[2] == 1);
+    REQUIRE(scores[3] == 1);
+    REQUIRE(scores[4] == 1);
+    REQUIRE(betcent.getAirportsWithMinFrequency(1).size() == 4);
+
+    // the compatibility flag gives each pair to the one path Dijkstra finds
+    scores = betcent.getBrandesScores(g, true, true);
+    REQUIRE(scores[1] + scores[2] + scores[3] + scores[4] == 4);
+    REQUIRE((scores[1] != 1 || scores[2] != 1 || scores[3] != 1 || scores[4] != 1));
+}
+
+TEST_CASE("Brandes Matches Brute Force") {
+    mt19937 rng(46);
+    for (int i = 0; i < 30; i++) {
+        // grid coordinates on a plane give many equal distances, so ties are split in both modes
+        Graph g = randomGraph(rng, false, i % 2 == 0);
+        BetweenessCentrality betcent;
+        for (bool weighted : {true, false}) {
+            map<int, double> expected = bruteForceScores(g, weighted);
+            map<int, double> scores = betcent.getBrandesScores(g, weighted);
+            REQUIRE(scores.size() == expected.size());
+            for (auto score : scores) {
+                REQUIRE(abs(score.second - expected[score.first]) < 1e-9);
+            }
+        }
+    }
+}
+
+TEST_CASE("Brandes Is Identical For Any Number Of Threads") {
+    mt19937 rng(47);
+    vector<Graph> graphs;
+    for (int i = 0; i < 5; i++) { graphs.push_back(randomGraph(rng, true, false)); }
+    graphs.push_back(syntheticData(500));
+    graphs.push_back(Graph());
+    for (const Graph& g : graphs) {
+        BetweenessCentrality betcent;
+        for (bool weighted : {true, false}) {
+            map<int, double> expected = betcent.getBrandesScores(g, weighted, false, false, 1);
+            for (int threads : {2, 3, 8, 0}) {
+                // compared with ==, so every score must match to the last bit
+                REQUIRE(betcent.getBrandesScores(g, weighted, false, false, threads) == expected);
+            }
+        }
+        map<int, double> single = betcent.getBrandesScores(g, true, true, false, 1);
+        REQUIRE(betcent.getBrandesScores(g, true, true, false, 5) == single);
+    }
+}
+
+TEST_CASE("Approximate Betweenness Within Epsilon") {
+    mt19937 rng(48);
+    vector<Graph> graphs;
+    for (int i = 0; i < 6; i++) { graphs.push_back(randomGraph(rng, false, i % 2 == 0)); }
+    graphs.push_back(syntheticData(300));
+    double epsilon = 0.03;
+    for (const Graph& g : graphs) {
+        BetweenessCentrality betcent;
+        double pairs = (double)g.size() * (g.size() - 1);
+        for (bool weighted : {true, false}) {
+            map<int, double> exact = betcent.getBrandesScores(g, weighted);
+            map<int, double> estimate = betcent.getApproximateScores(g, epsilon, 0.1, weighted, 7);
+            REQUIRE(estimate.size() == exact.size());
+            for (auto score : estimate) {
+                REQUIRE(abs(score.second - exact[score.first]) / pairs <= epsilon);
+            }
+            // the same seed gives the same estimates on any number of threads
+            REQUIRE(betcent.getApproximateScores(g, epsilon, 0.1, weighted, 7, 3) == estimate);
+        }
+    }
+}
+
+TEST_CASE("Approximate Betweenness Stops Early") {
+    // no airport lies on any path, which the Bernstein bound certifies long before the sample cap
+    Graph g;
+    for (int i = 1; i <= 50; i++) { g.addNode(i, "air", i, i); }
+    BetweenessCentrality betcent;
+    map<int, double> estimate = betcent.getApproximateScores(g, 0.01, 0.1);
+    REQUIRE(estimate.size() == 50);
+    REQUIRE(betcent.samplesTaken() > 0);
+    REQUIRE(betcent.samplesTaken() < 10000);
+    for (auto score : estimate) { REQUIRE(score.second == 0); }
+
+    REQUIRE(betcent.getApproximateScores(g, 0, 0.1).empty());
+    REQUIRE(betcent.getApproximateScores(g, 0.1, 1).empty());
+    REQUIRE(betcent.samplesTaken() == 0);
+}
+
+TEST_CASE("Progressive Betweenness Finishes Exact") {
+    mt19937 rng(49);
+    for (int i = 0; i < 4; i++) {
+        Graph g = randomGraph(rng, false, i % 2 == 0);
+        BetweenessCentrality betcent;
+        map<int, double> exact = betcent.getBrandesScores(g, true);
+        ProgressiveBetweenness progressive(g, true, 5);
+        REQUIRE(progressive.snapshot()->sources == 0);
+        progressive.start(2, 1);
+        progressive.wait();
+        REQUIRE(progressive.finished());
+        shared_ptr<const CentralitySnapshot> done = progressive.snapshot();
+        REQUIRE(done->sources == (int)g.size());
+        REQUIRE((int)done->ranking.size() == g.size());
+        for (const CentralityEstimate& estimate : done->ranking) {
+            REQUIRE(estimate.margin == 0);
+            REQUIRE(abs(estimate.score - exact[estimate.id]) <= 1e-9 * max(1.0, exact[estimate.id]));
+        }
+    }
+}
+
+TEST_CASE("Progressive Betweenness Stops And Resumes") {
+    Graph g = syntheticData(2000);
+    ProgressiveBetweenness progressive(g, false);
+    progressive.start(2);
+    // wait for the first snapshot, then pause
+    while (progressive.snapshot()->sources == 0) { this_thread::yield(); }
+    progressive.stop();
+    shared_ptr<const CentralitySnapshot> partial = progressive.snapshot();
+    REQUIRE(partial->sources > 0);
+    REQUIRE(partial->totalSources == 2000);
+
+    vector<CentralityEstimate> top = progressive.topK(10);
+    REQUIRE(top.size() == 10);
+    for (size_t i = 1; i < top.size(); i++) { REQUIRE(top[i - 1].score >= top[i].score); }
+    REQUIRE(progressive.topK(5000).size() == 2000);
+
+    progressive.start(3);
+    progressive.wait();
+    REQUIRE(progressive.finished());
+    REQUIRE(progressive.snapshot()->sources == 2000);
+    BetweenessCentrality betcent;
+    map<int, double> exact = betcent.getBrandesScores(g, false);
+    for (const CentralityEstimate& estimate : progressive.snapshot()->ranking) {
+        REQUIRE(abs(estimate.score - exact[estimate.id]) <= 1e-9 * max(1.0, exact[estimate.id]));
+    }
+}
+
+/**
+* @brief Checks a DynamicBetweenness' scores against computing them from scratch
+*
+* @param g The graph
+* @param dynamic The scores kept for g
+* @param weighted Whether shortest means the least distance (true) or the fewest legs (false)
+*/
+static void checkDynamic(const Graph& g, const DynamicBetweenness& dynamic, bool weighted) {
+    BetweenessCentrality betcent;
+    map<int, double> exact = betcent.getBrandesScores(g, weighted);
+    map<int, double> kept = dynamic.getScores();
+    REQUIRE(kept.size() == exact.size());
+    REQUIRE(dynamic.matches(g.csr()));
+    for (auto score : exact) {
+        REQUIRE(abs(kept[score.first] - score.second) <= 1e-9 * max(1.0, score.second));
+        REQUIRE(dynamic.getScore(score.first) == kept[score.first]);
+    }
+}
+
+TEST_CASE("Dynamic Betweenness Matches Recomputing") {
+    mt19937 rng(49);
+    for (int round = 0; round < 12; round++) {
+        bool grid = round % 3 == 0, weighted = round % 2 == 0;
+        Graph g = randomGraph(rng, round % 4 == 1, grid);
+        vector<int> ids = g.getIDs();
+        DynamicBetweenness dynamic(weighted);
+        dynamic.build(g, 1 + round % 3);
+        REQUIRE(dynamic.sourcesUpdated() == g.size());
+        checkDynamic(g, dynamic, weighted);
+        for (int change = 0; change < 15; change++) {
+            int from = ids[rng() % ids.size()], to = ids[rng() % ids.size()];
+            bool existed = g.connectedTo(from, to);
+            bool changed = rng() % 2 == 0 ? dynamic.connect(g, from, to, 2) : dynamic.disconnect(g, from, to, 2);
+            if (changed) {
+                REQUIRE(g.connectedTo(from, to) != existed);
+                REQUIRE(dynamic.sourcesUpdated() <= g.size());
+            } else {
+                REQUIRE(g.connectedTo(from, to) == existed);
+                REQUIRE(dynamic.sourcesUpdated() == 0);
+            }
+            checkDynamic(g, dynamic, weighted);
+        }
+    }
+}
+
+TEST_CASE("Dynamic Betweenness Only Searches Affected Sources") {
+
+    /*
+
+        |1|----->|2|----->|3|----->|4|
+
+                          |5|----->|6|
+
+    */
+
+    Graph g(false);
+    for (int i = 1; i <= 4; i++) { g.addNode(i, "air", 0, i); }
+    g.addNode(5, "air", 1, 3);
+    g.addNode(6, "air", 1, 4);
+    g.connect(1,2);
+    g.connect(2,3);
+    g.connect(3,4);
+    g.connect(5,6);
+
+    DynamicBetweenness dynamic;
+    REQUIRE(!dynamic.connect(g, 1, 3));
+    dynamic.build(g);
+    REQUIRE(dynamic.getScore(2) == 2);
+    REQUIRE(dynamic.getScore(3) == 2);
+    REQUIRE(dynamic.getScore(7) == 0);
+
+    // only 5 reaches 5 (itself) to go on to 3
+    REQUIRE(dynamic.connect(g, 5, 3));
+    REQUIRE(dynamic.sourcesUpdated() == 1);
+    REQUIRE(dynamic.getScore(3) == 3);
+    checkDynamic(g, dynamic, true);
+
+    // 1 and 2 used the cut route
+    REQUIRE(dynamic.disconnect(g, 2, 3));
+    REQUIRE(dynamic.sourcesUpdated() == 2);
+    REQUIRE(dynamic.getScore(2) == 0);
+    REQUIRE(dynamic.getScore(3) == 1);
+    checkDynamic(g, dynamic, true);
+
+    REQUIRE(!dynamic.connect(g, 5, 3));
+    REQUIRE(!dynamic.disconnect(g, 2, 3));
+    REQUIRE(!dynamic.connect(g, 1, 1));
+    REQUIRE(!dynamic.connect(g, 1, 9));
+
+    // changes made around it are refused until rebuilt
+    g.connect(4, 1);
+    REQUIRE(!dynamic.matches(g.csr()));
+    REQUIRE(!dynamic.connect(g, 1, 3));
+    REQUIRE(!g.connectedTo(1, 3));
+    dynamic.build(g);
+    REQUIRE(dynamic.connect(g, 1, 3));
+    checkDynamic(g, dynamic, true);
+}
+
+TEST_CASE("Dynamic Betweenness On A Synthetic Network") {
+    Graph g = syntheticData(600);
+    vector<int> ids = g.getIDs();
+    mt19937 rng(50);
+    for (bool weighted : {true, false}) {
+        DynamicBetweenness dynamic(weighted);
+        dynamic.build(g);
+        REQUIRE(dynamic.bytes() > 0);
+        for (int change = 0; change < 6; change++) {
+            int from = ids[rng() % ids.size()];
+            vector<int> routes = g.getConnections(from);
+            if (change % 2 == 0 && !routes.empty()) {
+                REQUIRE(dynamic.disconnect(g, from, routes[rng() % routes.size()]));
+            } else {
+                int to = ids[rng() % ids.size()];
+                bool refused = from == to || g.connectedTo(from, to);
+                REQUIRE(dynamic.connect(g, from, to) != refused);
+            }
+            REQUIRE(dynamic.sourcesUpdated() < g.size());
+        }
+        checkDynamic(g, dynamic, weighted);
+    }
+}
+
+/**
+* @brief Checks a top-k ranking against exact scores
+*
+* @param exact Every airport's exact score
+* @param top The ranking
+* @param k The number of airports asked for
+* @param tolerance How far apart airports out of order may be
+*/
+static void checkTop(const map<int, double>& exact, const vector<CentralityEstimate>& top, int k, double tolerance) {
+    REQUIRE((int)top.size() == min(k, (int)exact.size()));
+    set<int> ranked;
+    for (size_t i = 0; i < top.size(); i++) {
+        ranked.insert(top[i].id);
+        REQUIRE(abs(top[i].score - exact.at(top[i].id)) <= top[i].margin + 1e-9 * max(1.0, exact.at(top[i].id)));
+        for (size_t j = i + 1; j < top.size(); j++) {
+            REQUIRE(exact.at(top[j].id) - exact.at(top[i].id) <= tolerance + 1e-6);
+        }
+    }
+    REQUIRE(ranked.size() == top.size());
+    for (auto score : exact) {
+        if (ranked.count(score.first)) { continue; }
+        for (const CentralityEstimate& estimate : top) {
+            REQUIRE(score.second - exact.at(estimate.id) <= tolerance + 1e-6);
+        }
+    }
+}
+
+TEST_CASE("Top Betweenness Matches Brandes On Small Graphs") {
+    mt19937 rng(50);
+    for (int round = 0; round < 12; round++) {
+        Graph g = randomGraph(rng, round % 2 == 0, round % 3 == 0);
+        BetweenessCentrality betcent;
+        for (bool weighted : {true, false}) {
+            map<int, double> exact = betcent.getBrandesScores(g, weighted);
+            // too few sources to sample, so every score is exact
+            vector<CentralityEstimate> top = betcent.getTopScores(g, 5, 0, 0.1, weighted);
+            checkTop(exact, top, 5, 0);
+            for (const CentralityEstimate& estimate : top) { REQUIRE(estimate.margin == 0); }
+        }
+    }
+}
+
+TEST_CASE("Top Betweenness Covers Spokes Through Their Hubs") {
+
+    /*
+
+        |1|-------|2|-------|3|-------|4|
+                 /   \               |
+               |5|   |6|            |7|
+
+    */
+
+    Graph g(false);
+    for (int i = 1; i <= 4; i++) { g.addNode(i, "air", 0, i); }
+    g.addNode(5, "air", 1, 1);
+    g.addNode(6, "air", 1, 3);
+    g.addNode(7, "air", 1, 4);
+    for (pair<int, int> route : vector<pair<int, int>>({{1, 2}, {2, 3}, {3, 4}, {2, 5}, {2, 6}, {4, 7}})) {
+        g.connect(route.first, route.second);
+        g.connect(route.second, route.first);
+    }
+
+    BetweenessCentrality betcent;
+    map<int, double> exact = betcent.getBrandesScores(g);
+    vector<CentralityEstimate> top = betcent.getTopScores(g, 3, 0, 0.1);
+    // 1, 5, 6 and 7 are spokes, so only 2, 3 and 4 are searched
+    REQUIRE(betcent.sourcesSearched() == 3);
+    checkTop(exact, top, 3, 0);
+    REQUIRE(top[0].id == 2);
+    REQUIRE(top[0].score == exact[2]);
+    REQUIRE(betcent.getAirportsWithMinFrequency(1).size() == 3);
+
+    REQUIRE(betcent.getTopScores(g, 10, 0, 0.1).size() == 7);
+    REQUIRE(betcent.getTopScores(g, 0, 0, 0.1).empty());
+    REQUIRE(betcent.getTopScores(g, 3, -0.1, 0.1).empty());
+    REQUIRE(betcent.getTopScores(g, 3, 0, 1).empty());
+    REQUIRE(betcent.getTopScores(Graph(), 3, 0, 0.1).empty());
+}
+
+TEST_CASE("Top Betweenness Certifies A Sampled Ranking") {
+    Graph g = syntheticData(400);
+    BetweenessCentrality betcent;
+    map<int, double> exact = betcent.getBrandesScores(g);
+    double pairs = (double)g.size() * (g.size() - 1);
+    int everySource = g.size();
+    for (double epsilon : {0.0, 0.02}) {
+        vector<CentralityEstimate> top = betcent.getTopScores(g, 10, epsilon, 0.05, true, 3);
+        int searched = betcent.sourcesSearched();
+        // with the same order of sources, a looser ranking never needs more of them
+        REQUIRE(searched <= everySource);
+        everySource = searched;
+        // the exact order is only ever given once the bounds certify it
+        if (epsilon == 0) {
+            REQUIRE(betcent.rankingCertified());
+        }
+        checkTop(exact, top, 10, epsilon * pairs);
+
+        // the same seed gives the same ranking on any number of threads
+        vector<CentralityEstimate> threaded = betcent.getTopScores(g, 10, epsilon, 0.05, true, 3, 3);
+        REQUIRE(betcent.sourcesSearched() == searched);
+        REQUIRE(threaded.size() == top.size());
+        for (size_t i = 0; i < top.size(); i++) {
+            REQUIRE(threaded[i].id == top[i].id);
+            REQUIRE(threaded[i].score == top[i].score);
+            REQUIRE(threaded[i].margin == top[i].margin);
+        }
+    }
+}
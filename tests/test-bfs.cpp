@@ -6,6 +6,10 @@
 #include <stdexcept>
 
 #include "Algorithms/bfs.h"
+#include "Algorithms/direction_bfs.h"
+#include "Algorithms/dijkstra.h"
+
+#include <algorithm>
 
 
 TEST_CASE("Disconected Graph") {
@@ -140,3 +144,152 @@ TEST_CASE("Globe Data") {
    expected = {4049};
    REQUIRE(actual == expected);
 }
+
+TEST_CASE("BFS Avoiding Airports") {
+   vector<int> ids = {2279, 3484, 3469, 3830, 3748, 4049};
+   Graph g = readData("../Data/airports.dat", "../Data/routes.dat", ids);
+   BFS bfs;
+   SearchMask mask;
+
+   // banning ORD is the same as leaving it out of the graph, as in Globe Data
+   mask.clear(g.csr());
+   mask.banAirport(g.csr(), 3830);
+   REQUIRE(bfs.traversalOfBFS(g, 4049, &mask) == vector<int>({4049}));
+   REQUIRE(bfs.traversalOfBFS(g, 3830, &mask).empty());
+
+   // banning only CMI -> ORD leaves ORD reachable from everywhere else
+   mask.clear(g.csr());
+   REQUIRE(mask.banRoute(g.csr(), 4049, 3830));
+   REQUIRE(bfs.traversalOfBFS(g, 4049, &mask) == vector<int>({4049}));
+   REQUIRE(bfs.traversalOfBFS(g, 3469, &mask) == bfs.traversalOfBFS(g, 3469));
+}
+
+TEST_CASE("Parallel BFS Visits The Same Airports") {
+   Graph g = readData("../Data/airports.dat", "../Data/routes.dat");
+   Graph synthetic = syntheticData(3000);
+   BFS bfs;
+   DirectionOptimizingBFS levels;
+   for (const Graph* graph : {&g, &synthetic}) {
+      const CSRGraph& csr = graph->csr();
+      for (int start : {csr.getID(0), csr.getID(csr.size() / 2), 3830, 4049, 1}) {
+         if (csr.getIndex(start) == -1) {
+            continue;
+         }
+         vector<int> expected = bfs.traversalOfBFS(*graph, start);
+         // with one thread the order is exactly traversalOfBFS's
+         REQUIRE(bfs.parallelTraversalOfBFS(*graph, start, 1) == expected);
+
+         // with more, the airports are the same and come level by level
+         levels.run(*graph, start);
+         for (int threads : {2, 3, 8}) {
+            vector<int> actual = bfs.parallelTraversalOfBFS(*graph, start, threads);
+            REQUIRE(bfs.getPath() == actual);
+            REQUIRE(actual.front() == start);
+            for (size_t i = 1; i < actual.size(); i++) {
+               REQUIRE(levels.getLevels()[csr.getIndex(actual[i - 1])] <= levels.getLevels()[csr.getIndex(actual[i])]);
+            }
+            sort(actual.begin(), actual.end());
+            vector<int> sorted = expected;
+            sort(sorted.begin(), sorted.end());
+            REQUIRE(actual == sorted);
+         }
+      }
+   }
+
+   SearchMask mask;
+   mask.clear(g.csr());
+   mask.banAirport(g.csr(), 3830);
+   vector<int> expected = bfs.traversalOfBFS(g, 4049, &mask);
+   vector<int> actual = bfs.parallelTraversalOfBFS(g, 4049, 4, &mask);
+   sort(expected.begin(), expected.end());
+   sort(actual.begin(), actual.end());
+   REQUIRE(actual == expected);
+   REQUIRE(bfs.parallelTraversalOfBFS(g, 3830, 4, &mask).empty());
+   REQUIRE(bfs.parallelTraversalOfBFS(g, -5, 4).empty());
+}
+
+TEST_CASE("BFS Neighbourhood Stops At The Limit") {
+   Graph g = readData("../Data/airports.dat", "../Data/routes.dat");
+   const CSRGraph& csr = g.csr();
+   BFS bfs;
+   DirectionOptimizingBFS levels;
+   for (int start : {3830, 4049, 1}) {
+      vector<int> order = bfs.traversalOfBFS(g, start);
+      levels.run(g, start);
+      for (int maxLegs : {0, 1, 2, 3, 20}) {
+         vector<HopNeighbour> found = bfs.neighbourhood(g, start, maxLegs);
+         // the airports within the limit, in traversalOfBFS's order, each with its level
+         size_t expected = 0;
+         for (int id : order) {
+            if (levels.getLevels()[csr.getIndex(id)] <= maxLegs) {
+               expected++;
+            }
+         }
+         REQUIRE(found.size() == expected);
+         for (size_t i = 0; i < found.size(); i++) {
+            REQUIRE(found[i].id == order[i]);
+            REQUIRE(found[i].legs == levels.getLevels()[csr.getIndex(found[i].id)]);
+         }
+      }
+   }
+   REQUIRE(bfs.neighbourhood(g, 3830, -1).empty());
+   REQUIRE(bfs.neighbourhood(g, -5, 2).empty());
+}
+
+TEST_CASE("BFS Neighbourhood Level Callbacks") {
+   vector<int> ids = {2279, 3484, 3469, 3830, 3748, 4049};
+   Graph g = readData("../Data/airports.dat", "../Data/routes.dat", ids);
+   BFS bfs;
+
+   // CMI -> ORD -> NRT, SFO, LAX, SJC
+   vector<vector<int>> seen;
+   vector<HopNeighbour> found = bfs.neighbourhood(g, 4049, 10, [&](int level, const vector<int>& airports) {
+      REQUIRE(level == (int)seen.size());
+      seen.push_back(airports);
+      return true;
+   });
+   REQUIRE(found.size() == 6);
+   REQUIRE(seen.size() == 3);
+   REQUIRE(seen[0] == vector<int>({4049}));
+   REQUIRE(seen[1] == vector<int>({3830}));
+   REQUIRE(seen[2].size() == 4);
+
+   // returning false stops after the level
+   found = bfs.neighbourhood(g, 4049, 10, [](int level, const vector<int>&) { return level < 1; });
+   REQUIRE(found.size() == 2);
+   REQUIRE(found[1].id == 3830);
+   REQUIRE(found[1].legs == 1);
+
+   SearchMask mask;
+   mask.clear(g.csr());
+   mask.banAirport(g.csr(), 3830);
+   found = bfs.neighbourhood(g, 4049, 10, nullptr, &mask);
+   REQUIRE(found.size() == 1);
+}
+
+TEST_CASE("BFS Neighbourhood Callbacks Running Searches") {
+   Graph g = readData("../Data/airports.dat", "../Data/routes.dat");
+   BFS bfs;
+   vector<HopNeighbour> expected = bfs.neighbourhood(g, 4049, 3);
+
+   // every level's first airport is routed to from the start, and has its own neighbourhood found with the
+   // same BFS, in the middle of the traversal
+   Dijkstras dij;
+   vector<vector<int>> seen;
+   vector<HopNeighbour> found = bfs.neighbourhood(g, 4049, 3, [&](int level, const vector<int>& airports) {
+      vector<int> copy = airports;
+      vector<int> path = dij.getPath(g, 4049, airports[0]);
+      REQUIRE((int)path.size() >= level + 1);
+      vector<HopNeighbour> inner = bfs.neighbourhood(g, airports[0], 1);
+      REQUIRE(inner[0].id == airports[0]);
+      REQUIRE(airports == copy);
+      seen.push_back(airports);
+      return true;
+   });
+   REQUIRE(seen.size() == 4);
+   REQUIRE(found.size() == expected.size());
+   for (size_t i = 0; i < found.size(); i++) {
+      REQUIRE(found[i].id == expected[i].id);
+      REQUIRE(found[i].legs == expected[i].legs);
+   }
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "IntegerGraph.h"
+#include "Algorithms/dijkstra.h"
+#include "Algorithms/shortest_paths.h"
+
+#include <vector>
+#include <random>
+#include <limits>
+
+using namespace std;
+
+/**
+* @brief Finds every airport reachable from each airport by plain BFS
+*
+* @param csr The snapshot
+* @return vector<vector<bool>> Whether each airport (row) reaches each airport (column), by dense index
+*/
+static vector<vector<bool>> reachability(const CSRGraph& csr) {
+    int n = csr.size();
+    vector<vector<bool>> reaches(n, vector<bool>(n, false));
+    for (int s = 0; s < n; s++) {
+        vector<int> queue(1, s);
+        reaches[s][s] = true;
+        for (size_t front = 0; front < queue.size(); front++) {
+            int u = queue[front];
+            for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+                if (!reaches[s][csr.target(e)]) {
+                    reaches[s][csr.target(e)] = true;
+                    queue.push_back(csr.target(e));
+                }
+            }
+        }
+    }
+    return reaches;
+}
+
+/**
+* @brief Checks the component labels of a snapshot against brute-force reachability
+*
+* @param csr The snapshot
+*/
+static void checkComponents(const CSRGraph& csr) {
+    int n = csr.size();
+    vector<vector<bool>> reaches = reachability(csr);
+    for (int u = 0; u < n; u++) {
+        REQUIRE(csr.weakComponent(u) >= 0);
+        REQUIRE(csr.weakComponent(u) < csr.weakComponents());
+        REQUIRE(csr.strongComponent(u) >= 0);
+        REQUIRE(csr.strongComponent(u) < csr.strongComponents());
+        for (int v = 0; v < n; v++) {
+            bool strong = reaches[u][v] && reaches[v][u];
+            REQUIRE((csr.strongComponent(u) == csr.strongComponent(v)) == strong);
+            if (reaches[u][v]) {
+                REQUIRE(csr.weakComponent(u) == csr.weakComponent(v));
+                REQUIRE(csr.mayReach(u, v));
+            }
+        }
+        // connections never lead to a higher component
+        for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+            REQUIRE(csr.strongComponent(u) >= csr.strongComponent(csr.target(e)));
+        }
+    }
+}
+
+TEST_CASE("Components Match Reachability On Random Graphs") {
+    mt19937 rng(41);
+    for (int round = 0; round < 40; round++) {
+        Graph g;
+        int n = 2 + rng() % 30;
+        for (int i = 1; i <= n; i++) { g.addNode(i * 3, "air", rng() % 90, rng() % 180); }
+        int routes = rng() % (2 * n);
+        for (int i = 0; i < routes; i++) { g.connect(3 + rng() % n * 3, 3 + rng() % n * 3); }
+        checkComponents(g.csr());
+    }
+}
+
+TEST_CASE("Components Of Unconnected Islands") {
+
+    /*
+
+        |1|-------|2|          |6|----->|5|-------|7|
+                  /                      |
+                 /                       |
+                /                       |4|
+              |3|
+
+    */
+
+    Graph g;
+    for (int i = 1; i <= 7; i++) { g.addNode(i, "air", 0, i); }
+    g.connect(1,2);
+    g.connect(2,1);
+    g.connect(2,3);
+    g.connect(3,2);
+    g.connect(6,5);
+    g.connect(5,7);
+    g.connect(7,5);
+    g.connect(5,4);
+    g.connect(4,5);
+
+    const CSRGraph& csr = g.csr();
+    checkComponents(csr);
+    REQUIRE(csr.weakComponents() == 2);
+    REQUIRE(csr.strongComponents() == 3);
+    int one = csr.getIndex(1), five = csr.getIndex(5), six = csr.getIndex(6);
+    REQUIRE(!csr.mayReach(one, five));
+    REQUIRE(!csr.mayReach(five, six));
+    REQUIRE(csr.mayReach(six, five));
+
+    Dijkstras d;
+    REQUIRE(d.getPath(g, 1, 5).empty());
+    REQUIRE(d.getPath(g, 5, 6).empty());
+    REQUIRE(d.getPath(g, 6, 4) == vector<int>({6, 5, 4}));
+    IntegerGraph rounded(g);
+    REQUIRE(d.getPath(rounded, 5, 6).empty());
+    REQUIRE(d.getPath(rounded, 6, 7) == vector<int>({6, 5, 7}));
+}
+
+TEST_CASE("Components Rule Out Dijkstra Paths") {
+    Graph g = readData("../Data/airports.dat", "../Data/routes.dat");
+    const CSRGraph& csr = g.csr();
+    REQUIRE(csr.weakComponents() > 1);
+    REQUIRE(csr.strongComponents() > csr.weakComponents());
+
+    // one-to-all trees do not use the labels, so they show which pairs really have a path
+    mt19937 rng(7);
+    Dijkstras d;
+    vector<double> distances;
+    int ruledOut = 0;
+    for (int i = 0; i < 20; i++) {
+        int s = rng() % csr.size();
+        shortestDistances(csr, s, false, distances);
+        for (int j = 0; j < 40; j++) {
+            int t = rng() % csr.size();
+            bool reachable = distances[t] != numeric_limits<double>::infinity();
+            if (!csr.mayReach(s, t)) {
+                ruledOut++;
+                REQUIRE(!reachable);
+            }
+            if (csr.strongComponent(s) == csr.strongComponent(t)) {
+                REQUIRE(reachable);
+            }
+            REQUIRE(d.getPath(g, csr.getID(s), csr.getID(t)).empty() == !reachable);
+        }
+    }
+    REQUIRE(ruledOut > 0);
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+
+#include <iostream>
+
+#include "Algorithms/contraction.h"
+#include "Algorithms/dijkstra.h"
+
+using namespace std;
+
+/**
+* @brief Determines if a path follows connections of a graph and has the given length
+*
+* @param g The graph
+* @param path The path of IDs
+* @param distance The expected length
+* @return bool Whether the path is valid
+*/
+static bool validPath(const Graph& g, const vector<int>& path, double distance) {
+    double total = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        if (!g.connectedTo(path[i - 1], path[i])) { return false; }
+        total += g.getDistance(path[i - 1], path[i]);
+    }
+    return abs(total - distance) < 1e-6;
+}
+
+TEST_CASE("Simple Contraction Hierarchy") {
+
+    /*
+            |2| ----- |3|
+          /            |
+        /              |
+    |1|                | 
+        \              | 
+         \             |
+          |4| ------- |5|
+                       |
+                      |6|  
+    */
+
+    Graph g;
+
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 1, 1);
+    g.addNode(3, "three", 2, 1);
+    g.addNode(4, "four", 1, -1);
+    g.addNode(5, "five", 2, -1);
+    g.addNode(6, "six", 2, -2);
+
+    g.connect(1, 2);
+    g.connect(1, 4);
+    g.connect(2, 4);
+    g.connect(2, 3);
+    g.connect(4, 5);
+    g.connect(3, 5);
+    g.connect(5, 6);
+
+    ContractionHierarchy ch;
+    ch.build(g);
+    REQUIRE(ch.size() == 6);
+    REQUIRE(ch.matches(g.csr()));
+
+    vector<int> expected = {1, 4, 5, 6};
+    REQUIRE(ch.getPath(1, 6) == expected);
+    Dijkstras dij;
+    dij.getPath(g, 1, 6);
+    REQUIRE(abs(ch.shortestDistance() - dij.shortestDistance()) < 1e-9);
+
+    REQUIRE(ch.getPath(6, 1) == vector<int>());
+    REQUIRE(ch.shortestDistance() == numeric_limits<double>::infinity());
+    // 6 has no routes out, so the pair is rejected without searching
+    REQUIRE(ch.settledCount() == 0);
+    REQUIRE(ch.getPath(4, 4) == vector<int>(1, 4));
+    REQUIRE(ch.getPath(1, 42) == vector<int>());
+}
+
+TEST_CASE("Contraction Hierarchy Matches Dijkstra") {
+    Graph g = syntheticData(400, 3, 7);
+    ContractionHierarchy ch;
+    ch.build(g);
+    cout << "hierarchy with " << ch.shortcutCount() << " shortcuts" << endl;
+
+    vector<int> ids = g.getIDs();
+    for (size_t i = 0; i < ids.size(); i += 37) {
+        for (size_t j = 5; j < ids.size(); j += 53) {
+            Dijkstras dij;
+            vector<int> expected = dij.getPath(g, ids[i], ids[j]);
+            vector<int> actual = ch.getPath(ids[i], ids[j]);
+            REQUIRE(abs(ch.shortestDistance() - dij.shortestDistance()) < 1e-6);
+            REQUIRE(actual.size() > 0);
+            REQUIRE(actual.front() == ids[i]);
+            REQUIRE(actual.back() == ids[j]);
+            REQUIRE(validPath(g, actual, dij.shortestDistance()));
+        }
+    }
+}
+
+TEST_CASE("Contraction Hierarchy Airports") {
+    vector<int> ids;
+    for (int i = 0; i <= 6000; i += 1) {
+        ids.push_back(i);
+    }
+    Graph g = readData("../Data/airports.dat",  "../Data/routes.dat", ids);
+    ContractionHierarchy ch;
+    ch.build(g);
+
+    int champ = 4049;
+    int hgk = 3077;
+    vector<int> expected = {4049, 3830, 3077};
+    REQUIRE(ch.getPath(champ, hgk) == expected);
+
+    Dijkstras dij;
+    dij.getPath(g, 5438, 5695);
+    vector<int> path = ch.getPath(5438, 5695);
+    REQUIRE(abs(ch.shortestDistance() - dij.shortestDistance()) < 1e-6);
+    REQUIRE(validPath(g, path, dij.shortestDistance()));
+}
+
+TEST_CASE("Contraction Hierarchy Rejects Unreachable Pairs") {
+    Graph g = readData("../Data/airports.dat",  "../Data/routes.dat");
+    const CSRGraph& csr = g.csr();
+    ContractionHierarchy ch;
+    ch.build(g);
+    Dijkstras dij;
+    int rejected = 0;
+    for (int i = 0; i < 300; i++) {
+        int s = (i * 7919) % csr.size(), t = (i * 104729 + 13) % csr.size();
+        double distance = ch.getDistance(csr.getID(s), csr.getID(t));
+        if (!csr.mayReach(s, t)) {
+            // no search at all for pairs the components already rule out
+            REQUIRE(distance == numeric_limits<double>::infinity());
+            REQUIRE(ch.settledCount() == 0);
+            rejected++;
+            continue;
+        }
+        dij.getPath(g, csr.getID(s), csr.getID(t));
+        REQUIRE((distance == dij.shortestDistance() || abs(distance - dij.shortestDistance()) < 1e-6));
+    }
+    REQUIRE(rejected > 0);
+}
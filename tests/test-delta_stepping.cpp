@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/delta_stepping.h"
+#include "Algorithms/shortest_paths.h"
+
+#include <limits>
+
+using namespace std;
+
+TEST_CASE("Simple Delta Stepping") {
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 0, 3);
+    g.addNode(4, "four", 9, 9);
+    g.connect(1, 2);
+    g.connect(2, 3);
+    g.connect(1, 3);
+
+    vector<double> distances;
+    deltaStepping(g.csr(), 0, distances, 0.5, 2);
+    REQUIRE(distances == vector<double>({0, 1, 3, numeric_limits<double>::infinity()}));
+    deltaStepping(g.csr(), 2, distances);
+    REQUIRE(distances[2] == 0);
+    REQUIRE(distances[0] == numeric_limits<double>::infinity());
+}
+
+TEST_CASE("Delta Stepping Matches Dijkstra") {
+    Graph g = syntheticData(2000);
+    const CSRGraph& csr = g.csr();
+    vector<double> expected, distances;
+    for (int source : {0, 777, 1999}) {
+        shortestDistances(csr, source, false, expected);
+        for (int threads : {1, 3, 8}) {
+            for (double delta : {0.0, 50.0, 5000.0}) {
+                deltaStepping(csr, source, distances, delta, threads);
+                REQUIRE(distances == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Delta Stepping With A Tiny Delta") {
+    // a chain of 100 airports a degree apart, with a bucket width far below any connection
+    Graph g(false);
+    for (int i = 0; i < 100; i++) { g.addNode(i, "air", 0, i); }
+    for (int i = 0; i + 1 < 100; i++) { g.connect(i, i + 1); }
+    const CSRGraph& csr = g.csr();
+    vector<double> expected, distances;
+    shortestDistances(csr, 0, false, expected);
+    for (int threads : {1, 4}) {
+        deltaStepping(csr, 0, distances, 1e-7, threads);
+        REQUIRE(distances == expected);
+    }
+}
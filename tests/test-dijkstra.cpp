@@ -266,3 +266,108 @@ TEST_CASE("Chicago,Illinois to Windohek,Namibia") {
     cout << "End of Dijkstra Test Cases" << endl;
 
 }
+
+TEST_CASE("Reused Workspace") {
+    // queries on graphs of different sizes share the thread's workspace, so none may see another's state
+    Graph small(false);
+    small.addNode(1, "one", 0, 0);
+    small.addNode(2, "two", 0, 1);
+    small.addNode(3, "three", 0, 2);
+    small.connect(1, 2);
+    small.connect(2, 3);
+
+    Graph large = syntheticData(300);
+    vector<int> ids = large.getIDs();
+
+    Dijkstras dij;
+    vector<int> path;
+    for (int i = 0; i < 20; i++) {
+        dij.getPath(small, 1, 3, path);
+        REQUIRE(path == vector<int>({1, 2, 3}));
+        REQUIRE(dij.shortestDistance() == 2);
+
+        dij.getPath(small, 3, 1, path);
+        REQUIRE(path.empty());
+        REQUIRE(dij.shortestDistance() == numeric_limits<double>::infinity());
+
+        vector<int> first = dij.getPath(large, ids[i], ids[ids.size() - 1 - i]);
+        double distance = dij.shortestDistance();
+        dij.getPath(large, ids[i], ids[ids.size() - 1 - i], path);
+        REQUIRE(path == first);
+        REQUIRE(dij.shortestDistance() == distance);
+    }
+
+    // changing the graph is seen by the next query
+    small.connect(1, 3);
+    dij.getPath(small, 1, 3, path);
+    REQUIRE(path == vector<int>({1, 3}));
+}
+
+TEST_CASE("Dijkstra Avoiding Airports") {
+    // a masked search must give the same answer as a search on a copy with the airports removed
+    Graph g = syntheticData(300);
+    vector<int> ids = g.getIDs();
+    const CSRGraph& csr = g.csr();
+    SearchMask mask;
+    mask.clear(csr);
+    Graph removed = g;
+    for (size_t i = 7; i < ids.size(); i += 11) {
+        REQUIRE(mask.banAirport(csr, ids[i]));
+        removed.removeNode(ids[i]);
+    }
+    // a route banned one way only is disconnected one way only
+    vector<int> out = g.getConnections(ids[0]);
+    REQUIRE(!out.empty());
+    REQUIRE(mask.banRoute(csr, ids[0], out[0]));
+    if (removed.inGraph(out[0])) { removed.disconnect(ids[0], out[0]); }
+    REQUIRE(!mask.banAirport(csr, -5));
+    REQUIRE(!mask.banRoute(csr, ids[0], -5));
+
+    Dijkstras masked, copied;
+    vector<int> path;
+    for (size_t i = 0; i < 40; i++) {
+        int source = ids[i], target = ids[ids.size() - 1 - i];
+        masked.getPath(g, source, target, path, &mask);
+        if (!removed.inGraph(source) || !removed.inGraph(target)) {
+            REQUIRE(path.empty());
+            continue;
+        }
+        REQUIRE(path == copied.getPath(removed, source, target));
+        REQUIRE(masked.shortestDistance() == copied.shortestDistance());
+    }
+
+    // the whole graph is still searchable without the mask
+    masked.getPath(g, ids[0], out[0], path);
+    REQUIRE(path == vector<int>({ids[0], out[0]}));
+}
+
+TEST_CASE("Dijkstra With A Mask Never Cleared") {
+    Graph g = syntheticData(300);
+    vector<int> ids = g.getIDs();
+    const CSRGraph& csr = g.csr();
+    // bans make room for themselves, so a mask that was never cleared works like a cleared one
+    SearchMask fresh, cleared;
+    cleared.clear(csr);
+    REQUIRE(fresh.banAirport(csr, ids.back()));
+    REQUIRE(cleared.banAirport(csr, ids.back()));
+    vector<int> out = g.getConnections(ids[0]);
+    REQUIRE(!out.empty());
+    SearchMask routes;
+    REQUIRE(routes.banRoute(csr, ids[0], out[0]));
+    REQUIRE(routes.edgeBanned(csr.findEdge(csr.getIndex(ids[0]), csr.getIndex(out[0]))));
+    SearchMask direct;
+    direct.banNode(csr.size() + 10);
+    direct.banEdge(csr.edges() + 10);
+    REQUIRE(direct.nodeBanned(csr.size() + 10));
+    REQUIRE(direct.edgeBanned(csr.edges() + 10));
+
+    Dijkstras dij;
+    vector<int> expected, path;
+    for (size_t i = 0; i < 20; i++) {
+        dij.getPath(g, ids[i], ids[ids.size() - 2 - i], expected, &cleared);
+        dij.getPath(g, ids[i], ids[ids.size() - 2 - i], path, &fresh);
+        REQUIRE(path == expected);
+    }
+    dij.getPath(g, ids[0], ids.back(), path, &fresh);
+    REQUIRE(path.empty());
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/direction_bfs.h"
+#include "Algorithms/bfs.h"
+
+#include <vector>
+
+using namespace std;
+
+/**
+* @brief Checks levels and parents against a plain BFS from the same start
+*
+* @param g The graph
+* @param search The search that ran
+* @param start The start ID
+* @param mask The bans the search used (nullptr for none)
+*/
+static void checkLevels(const Graph& g, const DirectionOptimizingBFS& search, int start, const SearchMask* mask) {
+    const CSRGraph& csr = g.csr();
+    vector<int> expected(csr.size(), -1);
+    vector<int> queue(1, csr.getIndex(start));
+    expected[queue[0]] = 0;
+    for (size_t front = 0; front < queue.size(); front++) {
+        int u = queue[front];
+        for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+            int v = csr.target(e);
+            if (expected[v] != -1 || (mask && (mask->edgeBanned(e) || mask->nodeBanned(v)))) { continue; }
+            expected[v] = expected[u] + 1;
+            queue.push_back(v);
+        }
+    }
+    REQUIRE(search.getLevels() == expected);
+    for (int v = 0; v < csr.size(); v++) {
+        int parent = search.getParents()[v];
+        if (expected[v] <= 0) {
+            REQUIRE(parent == -1);
+            continue;
+        }
+        REQUIRE(expected[parent] == expected[v] - 1);
+        int e = csr.findEdge(parent, v);
+        REQUIRE(e != -1);
+        REQUIRE(!(mask && mask->edgeBanned(e)));
+    }
+}
+
+TEST_CASE("Direction Optimizing BFS Matches BFS") {
+    Graph g = readData("../Data/airports.dat", "../Data/routes.dat");
+    BFS bfs;
+    // the default thresholds, always bottom-up after the first level, and always top-down
+    vector<DirectionOptimizingBFS> searches = {DirectionOptimizingBFS(), DirectionOptimizingBFS(1e18, 1e18),
+        DirectionOptimizingBFS(1e-18, 1)};
+    for (int start : {3830, 4049, 1, 8830}) {
+        vector<int> order = bfs.traversalOfBFS(g, start);
+        for (DirectionOptimizingBFS& search : searches) {
+            REQUIRE(search.run(g, start));
+            REQUIRE(search.getOrder().empty());
+            checkLevels(g, search, start, nullptr);
+            REQUIRE(search.run(g, start, true));
+            REQUIRE(search.getOrder() == order);
+            checkLevels(g, search, start, nullptr);
+        }
+        if (order.size() > 1) { REQUIRE(searches[1].bottomUpSteps() > 0); }
+        REQUIRE(searches[2].bottomUpSteps() == 0);
+    }
+    REQUIRE(!searches[0].run(g, -5));
+}
+
+TEST_CASE("Direction Optimizing BFS Avoiding Airports") {
+    Graph g = syntheticData(800);
+    const CSRGraph& csr = g.csr();
+    vector<int> ids = g.getIDs();
+    SearchMask mask;
+    mask.clear(csr);
+    for (size_t i = 3; i < ids.size(); i += 5) { mask.banAirport(csr, ids[i]); }
+    for (size_t i = 1; i < ids.size(); i += 9) {
+        vector<int> out = g.getConnections(ids[i]);
+        if (!out.empty()) { mask.banRoute(csr, ids[i], out[0]); }
+    }
+    BFS bfs;
+    for (DirectionOptimizingBFS search : {DirectionOptimizingBFS(), DirectionOptimizingBFS(1e18, 1e18)}) {
+        REQUIRE(search.run(g, ids[0], true, &mask));
+        checkLevels(g, search, ids[0], &mask);
+        REQUIRE(search.getOrder() == bfs.traversalOfBFS(g, ids[0], &mask));
+        REQUIRE(!search.run(g, ids[3], false, &mask));
+    }
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+
+#include <iostream>
+
+#include "Algorithms/distance_matrix.h"
+#include "Algorithms/dijkstra.h"
+
+using namespace std;
+
+TEST_CASE("Simple Distance Matrix") {
+
+    /*
+    |1| ------- |2| ------- |3|
+                 |
+                |4|         |5|
+    */
+
+    Graph g(false);
+
+    g.addNode(1, "one", 0, 1);
+    g.addNode(2, "two", 0, 2);
+    g.addNode(3, "three", 0, 3);
+    g.addNode(4, "four", 1, 2);
+    g.addNode(5, "five", 1, 3);
+
+    g.connect(1, 2);
+    g.connect(2, 1);
+    g.connect(2, 3);
+    g.connect(3, 2);
+    g.connect(2, 4);
+
+    vector<int> sources = {1, 3, 4, 42};
+    vector<int> targets = {3, 4, 5, 1};
+    DistanceMatrix matrix = distanceMatrix(g, sources, targets, true);
+    REQUIRE(matrix.rows() == 4);
+    REQUIRE(matrix.columns() == 4);
+    REQUIRE(matrix.getDistance(0, 0) == 2);
+    REQUIRE(matrix.getDistance(0, 1) == 2);
+    REQUIRE(matrix.getDistance(0, 2) == numeric_limits<double>::infinity());
+    REQUIRE(matrix.getDistance(1, 3) == 2);
+    REQUIRE(matrix.getDistance(2, 0) == numeric_limits<double>::infinity());
+    REQUIRE(matrix.getDistance(3, 0) == numeric_limits<double>::infinity());
+
+    vector<int> expected = {1, 2, 4};
+    REQUIRE(matrix.getPath(0, 1) == expected);
+    REQUIRE(matrix.getPath(0, 2) == vector<int>());
+
+    ContractionHierarchy ch;
+    ch.build(g);
+    DistanceMatrix buckets = distanceMatrix(ch, sources, targets, true);
+    REQUIRE(buckets.getDistances() == matrix.getDistances());
+    REQUIRE(buckets.getPath(0, 1) == expected);
+    expected = {3, 2, 1};
+    REQUIRE(buckets.getPath(1, 3) == expected);
+}
+
+TEST_CASE("Distance Matrix Matches Dijkstra") {
+    Graph g = syntheticData(500, 3, 11);
+    ContractionHierarchy ch;
+    ch.build(g);
+
+    vector<int> sources, targets;
+    for (int id = 1; id <= 500; id += 31) { sources.push_back(id); }
+    for (int id = 3; id <= 500; id += 43) { targets.push_back(id); }
+
+    DistanceMatrix searches = distanceMatrix(g, sources, targets, true, 2);
+    DistanceMatrix buckets = distanceMatrix(ch, sources, targets, true, 2);
+    for (int i = 0; i < searches.rows(); i++) {
+        for (int j = 0; j < searches.columns(); j++) {
+            Dijkstras dij;
+            vector<int> path = dij.getPath(g, sources[i], targets[j]);
+            REQUIRE(abs(searches.getDistance(i, j) - dij.shortestDistance()) < 1e-6);
+            REQUIRE(abs(buckets.getDistance(i, j) - dij.shortestDistance()) < 1e-6);
+
+            vector<int> bucketPath = buckets.getPath(i, j);
+            REQUIRE(bucketPath.front() == sources[i]);
+            REQUIRE(bucketPath.back() == targets[j]);
+            double total = 0;
+            for (size_t k = 1; k < bucketPath.size(); k++) {
+                REQUIRE(g.connectedTo(bucketPath[k - 1], bucketPath[k]));
+                total += g.getDistance(bucketPath[k - 1], bucketPath[k]);
+            }
+            REQUIRE(abs(total - dij.shortestDistance()) < 1e-6);
+            REQUIRE(searches.getPath(i, j).size() == path.size());
+        }
+    }
+}
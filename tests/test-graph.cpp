@@ -2,8 +2,11 @@
 
 #include "Graph.h"
 #include "readdat.h"
+#include "CSRGraph.h"
 #include <cmath>
 #include <algorithm>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -182,3 +185,44 @@ TEST_CASE("distance function") {
     g.connect(1, 1); // this is nonsensical but just used to test a distance of 0
     REQUIRE(g.getDistance(1, 1) == 0);
 }
+
+TEST_CASE("connection count") {
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 1, 0);
+
+    // disconnecting what is not connected changes nothing
+    g.connect(1, 2);
+    g.disconnect(2, 1);
+    g.disconnect(4, 1);
+    REQUIRE(g.connections() == 1);
+
+    // removing an airport drops the connections into it as well as out of it
+    g.connect(2, 1);
+    g.connect(3, 1);
+    g.connect(2, 3);
+    REQUIRE(g.connections() == 4);
+    g.removeNode(1);
+    REQUIRE(g.connections() == 1);
+    REQUIRE(g.getConnections(2) == vector<int>(1, 3));
+    REQUIRE(g.getConnections(3).empty());
+}
+
+TEST_CASE("snapshot built by several threads at once") {
+    Graph g = syntheticData(2000);
+    for (int round = 0; round < 20; round++) {
+        if (!g.connectedTo(1, 2 + round)) { g.connect(1, 2 + round); }
+        // every thread gets the one snapshot the graph keeps, whichever thread built it
+        vector<const CSRGraph*> seen(4, nullptr);
+        vector<thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.push_back(thread([&g, &seen, t]() { seen[t] = &g.csr(); }));
+        }
+        for (thread& worker : threads) { worker.join(); }
+        for (const CSRGraph* snapshot : seen) {
+            REQUIRE(snapshot == &g.csr());
+            REQUIRE(snapshot->edges() == g.connections());
+        }
+    }
+}
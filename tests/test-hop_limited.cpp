@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/hop_limited.h"
+#include "Algorithms/dijkstra.h"
+
+#include <random>
+#include <limits>
+#include <functional>
+
+using namespace std;
+
+TEST_CASE("Simple Hop Limited Paths") {
+    /*
+        |1| -> |2| -> |3| -> |4|
+         \___________________/^   (1 -> 4 directly is the long way round)
+    */
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 0, 2);
+    g.addNode(4, "four", 0, 3);
+    g.addNode(5, "five", 9, 9);
+    g.connect(1, 2);
+    g.connect(2, 3);
+    g.connect(3, 4);
+    g.connect(1, 5);
+    g.connect(5, 4);
+
+    HopLimitedPaths hops;
+    REQUIRE(hops.build(g, 1, 4));
+    double inf = numeric_limits<double>::infinity();
+    REQUIRE(hops.getDistance(4, 0) == inf);
+    REQUIRE(hops.getDistance(4, 1) == inf);
+    REQUIRE(hops.getPath(4, 2) == vector<int>({1, 5, 4}));
+    REQUIRE(hops.getPath(4, 3) == vector<int>({1, 2, 3, 4}));
+    REQUIRE(hops.getDistance(4, 3) == 3);
+    REQUIRE(hops.getPath(4, 4) == vector<int>({1, 2, 3, 4}));
+    REQUIRE(hops.getPath(1, 0) == vector<int>({1}));
+
+    REQUIRE(hops.getDistance(4, 5) == inf);
+    REQUIRE(hops.getPath(42, 2).empty());
+    REQUIRE(!hops.build(g, 42, 3));
+    REQUIRE(hops.maxLegs() == -1);
+    REQUIRE(hops.getDistance(1, 0) == inf);
+}
+
+TEST_CASE("Hop Limited Paths Match Brute Force") {
+    mt19937 generator(3);
+    for (int trial = 0; trial < 20; trial++) {
+        Graph g(true);
+        for (int id = 0; id < 8; id++) {
+            g.addNode(id, to_string(id), uniform_real_distribution<double>(-60, 60)(generator),
+                uniform_real_distribution<double>(-180, 180)(generator));
+        }
+        for (int i = 0; i < 24; i++) {
+            int a = generator() % 8, b = generator() % 8;
+            if (a != b) { g.connect(a, b); }
+        }
+
+        // the best distance to every airport over every walk of at most 4 legs
+        const int maxLegs = 4;
+        vector<vector<double>> best(maxLegs + 1, vector<double>(8, numeric_limits<double>::infinity()));
+        function<void(int, double, int)> walk = [&](int v, double distance, int legs) {
+            for (int k = legs; k <= maxLegs; k++) { best[k][v] = min(best[k][v], distance); }
+            if (legs == maxLegs) { return; }
+            for (int adj : g.getConnections(v)) { walk(adj, distance + g.getDistance(v, adj), legs + 1); }
+        };
+        walk(0, 0, 0);
+
+        HopLimitedPaths single, threaded;
+        REQUIRE(single.build(g, 0, maxLegs, 1));
+        REQUIRE(threaded.build(g, 0, maxLegs, 3));
+        REQUIRE(single.getDistances() == threaded.getDistances());
+        for (int k = 0; k <= maxLegs; k++) {
+            for (int v = 0; v < 8; v++) {
+                double distance = single.getDistance(v, k);
+                REQUIRE((distance == best[k][v] || abs(distance - best[k][v]) < 1e-6));
+                vector<int> path = single.getPath(v, k);
+                if (distance == numeric_limits<double>::infinity()) {
+                    REQUIRE(path.empty());
+                    continue;
+                }
+                REQUIRE((int)path.size() - 1 <= k);
+                REQUIRE(path.front() == 0);
+                REQUIRE(path.back() == v);
+                double length = 0;
+                for (size_t i = 1; i < path.size(); i++) {
+                    REQUIRE(g.connectedTo(path[i - 1], path[i]));
+                    length += g.getDistance(path[i - 1], path[i]);
+                }
+                REQUIRE(abs(length - distance) < 1e-6);
+            }
+        }
+    }
+}
+
+TEST_CASE("Hop Limited Paths Without A Limit Match Dijkstra") {
+    Graph g = syntheticData(400);
+    vector<int> ids = g.getIDs();
+    HopLimitedPaths hops;
+    REQUIRE(hops.build(g, ids[0], ids.size()));
+    Dijkstras dij;
+    for (size_t i = 1; i < ids.size(); i += 7) {
+        dij.getPath(g, ids[0], ids[i]);
+        double distance = hops.getDistance(ids[i], ids.size());
+        REQUIRE((distance == dij.shortestDistance() || abs(distance - dij.shortestDistance()) < 1e-6));
+    }
+}
@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/hop_matrix.h"
+#include "Algorithms/direction_bfs.h"
+
+#include <cstdio>
+
+using namespace std;
+
+TEST_CASE("Simple Hop Matrix") {
+    // |1| -> |2| -> |3|, and |4| on its own
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 0, 2);
+    g.addNode(4, "four", 5, 5);
+    g.connect(1, 2);
+    g.connect(2, 3);
+
+    HopMatrix matrix;
+    matrix.build(g);
+    REQUIRE(matrix.size() == 4);
+    REQUIRE(matrix.getHops(1, 1) == 0);
+    REQUIRE(matrix.getHops(1, 2) == 1);
+    REQUIRE(matrix.getHops(1, 3) == 2);
+    REQUIRE(matrix.getHops(3, 1) == HopMatrix::UNREACHABLE);
+    REQUIRE(matrix.getHops(1, 4) == HopMatrix::UNREACHABLE);
+    REQUIRE(matrix.getHops(1, 42) == HopMatrix::UNREACHABLE);
+
+    const HopStats& stats = matrix.getStats();
+    REQUIRE(stats.diameter == 2);
+    REQUIRE(stats.connectedPairs == 3);
+    REQUIRE(stats.averageHops == 4.0 / 3);
+    REQUIRE(stats.eccentricities == vector<int>({2, 1, 0, 0}));
+}
+
+TEST_CASE("Hop Matrix Matches BFS") {
+    // more than one batch of sources, so batches and rounds are both exercised
+    Graph g = syntheticData(700);
+    const CSRGraph& csr = g.csr();
+    vector<int> ids = g.getIDs();
+    for (int threads : {1, 3}) {
+        HopMatrix matrix;
+        matrix.build(g, threads);
+        DirectionOptimizingBFS bfs;
+        for (size_t i = 0; i < ids.size(); i += 13) {
+            bfs.run(g, ids[i]);
+            for (int v = 0; v < csr.size(); v++) {
+                int level = bfs.getLevels()[v];
+                REQUIRE(matrix.row(i)[v] == (level == -1 ? HopMatrix::UNREACHABLE : level));
+            }
+        }
+    }
+}
+
+TEST_CASE("Hop Matrix Write and Load") {
+    Graph g = syntheticData(300);
+    HopMatrix built;
+    built.build(g);
+
+    HopStats stats;
+    REQUIRE(HopMatrix::write(g, "hop_matrix_test.bin", 2, &stats));
+    REQUIRE(stats.diameter == built.getStats().diameter);
+    REQUIRE(stats.averageHops == built.getStats().averageHops);
+    REQUIRE(stats.eccentricities == built.getStats().eccentricities);
+
+    HopMatrix loaded;
+    REQUIRE(loaded.load("hop_matrix_test.bin", g));
+    REQUIRE(loaded.size() == built.size());
+    for (int v = 0; v < built.size(); v++) {
+        REQUIRE(equal(loaded.row(v), loaded.row(v) + built.size(), built.row(v)));
+    }
+    REQUIRE(loaded.getStats().diameter == built.getStats().diameter);
+
+    // a matrix is refused for a changed graph
+    vector<int> ids = g.getIDs();
+    g.connect(ids[0], ids[1]);
+    g.disconnect(ids[0], ids[1]);
+    g.connect(ids[1], ids[0]);
+    REQUIRE(!loaded.load("hop_matrix_test.bin", g));
+    REQUIRE(loaded.size() == built.size());
+    remove("hop_matrix_test.bin");
+}
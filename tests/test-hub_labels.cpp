@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/hub_labels.h"
+#include "Algorithms/dijkstra.h"
+#include "Algorithms/bet_cent.h"
+
+#include <fstream>
+#include <limits>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+/**
+* @brief Checks that hub label distances and paths match Dijkstra for many pairs
+*
+* @param g The graph
+* @param labels The labels built for g
+* @param pairs How many pairs to check
+*/
+static void checkAgainstDijkstra(const Graph& g, const HubLabels& labels, int pairs) {
+    vector<int> ids = g.getIDs();
+    Dijkstras dij;
+    for (int i = 0; i < pairs; i++) {
+        int source = ids[(i * 37) % ids.size()], target = ids[(i * 101 + 13) % ids.size()];
+        vector<int> expected = dij.getPath(g, source, target);
+        vector<int> path = labels.getPath(source, target);
+        double distance = labels.getDistance(source, target);
+        REQUIRE(path.empty() == expected.empty());
+        if (expected.empty()) {
+            REQUIRE(distance == numeric_limits<double>::infinity());
+            continue;
+        }
+        REQUIRE(abs(distance - dij.shortestDistance()) < 1e-6);
+        REQUIRE(path.front() == source);
+        REQUIRE(path.back() == target);
+        double length = 0;
+        for (size_t j = 1; j < path.size(); j++) {
+            REQUIRE(g.connectedTo(path[j - 1], path[j]));
+            length += g.getDistance(path[j - 1], path[j]);
+        }
+        REQUIRE(abs(length - distance) < 1e-6);
+    }
+}
+
+TEST_CASE("Simple Hub Labels") {
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 1, 1);
+    g.addNode(4, "four", 5, 5);
+    g.connect(1, 2);
+    g.connect(2, 3);
+    g.connect(3, 1);
+
+    HubLabels labels;
+    REQUIRE(labels.getPath(1, 3).empty());
+    labels.build(g);
+    REQUIRE(labels.matches(g.csr()));
+    REQUIRE(labels.getDistance(1, 3) == 2);
+    REQUIRE(labels.getPath(1, 3) == vector<int>({1, 2, 3}));
+    REQUIRE(labels.getPath(3, 2) == vector<int>({3, 1, 2}));
+    REQUIRE(labels.getPath(2, 2) == vector<int>({2}));
+    REQUIRE(labels.getPath(1, 4).empty());
+    REQUIRE(labels.getDistance(4, 1) == numeric_limits<double>::infinity());
+    REQUIRE(labels.getPath(1, 9).empty());
+}
+
+TEST_CASE("Hub Labels Match Dijkstra") {
+    Graph g = syntheticData(400);
+    HubLabels labels;
+    labels.build(g);
+    checkAgainstDijkstra(g, labels, 300);
+
+    // ordering by betweenness gives the same answers
+    BetweenessCentrality bc;
+    HubLabels byScore;
+    byScore.build(g, bc.getProbabilisticScores(g, 100, true, false));
+    checkAgainstDijkstra(g, byScore, 100);
+
+    vector<int> subset;
+    for (int id = 0; id <= 4000; id++) { subset.push_back(id); }
+    Graph airports = readData("../Data/airports.dat", "../Data/routes.dat", subset);
+    HubLabels airportLabels;
+    airportLabels.build(airports);
+    checkAgainstDijkstra(airports, airportLabels, 200);
+}
+
+TEST_CASE("Hub Labels Save, Load and Attach") {
+    Graph g = syntheticData(300);
+    HubLabels labels;
+    labels.build(g);
+    REQUIRE(labels.save("hub_labels_test.bin"));
+
+    HubLabels loaded;
+    REQUIRE(loaded.load("hub_labels_test.bin", g));
+    REQUIRE(loaded.labelEntries() == labels.labelEntries());
+    checkAgainstDijkstra(g, loaded, 100);
+
+    // the file's contents can be used in place
+    ifstream in("hub_labels_test.bin", ios::binary);
+    vector<uint64_t> contents(labels.bytes() / 8 + 1);
+    in.read((char*)contents.data(), labels.bytes());
+    HubLabels attached;
+    REQUIRE(attached.attach(contents.data(), labels.bytes(), g));
+    checkAgainstDijkstra(g, attached, 100);
+    REQUIRE_FALSE(attached.attach(contents.data(), labels.bytes() - 8, g));
+
+    // labels for another graph are rejected
+    Graph other = syntheticData(300, 3, 2);
+    REQUIRE_FALSE(loaded.load("hub_labels_test.bin", other));
+    REQUIRE_FALSE(attached.attach(contents.data(), labels.bytes(), other));
+    REQUIRE_FALSE(loaded.load("missing_hub_labels.bin", g));
+}
+
+TEST_CASE("Hub Labels Reject Corrupt Files") {
+    Graph g = syntheticData(300);
+    HubLabels labels;
+    labels.build(g);
+    REQUIRE(labels.save("hub_labels_test.bin"));
+    ifstream in("hub_labels_test.bin", ios::binary);
+    vector<uint64_t> contents(labels.bytes() / 8);
+    in.read((char*)contents.data(), labels.bytes());
+    in.close();
+
+    // the arrays' positions in the file, as laid out by save()
+    size_t n = labels.size();
+    auto aligned = [](size_t bytes) { return (bytes + 7) / 8 * 8; };
+    size_t hubs = aligned(48 + n * 4), outOffsets = aligned(hubs + n * 4), inOffsets = outOffsets + (n + 1) * 8;
+    size_t outLabels = inOffsets + (n + 1) * 8;
+
+    // attaches a copy with one value overwritten
+    auto accepts = [&](size_t position, auto value) {
+        vector<uint64_t> corrupt = contents;
+        memcpy((char*)corrupt.data() + position, &value, sizeof(value));
+        HubLabels attached;
+        return attached.attach(corrupt.data(), labels.bytes(), g);
+    };
+    REQUIRE(accepts(0, contents[0]));
+    REQUIRE_FALSE(accepts(24, uint64_t(1) << 60)); // far more forward entries than the file holds
+    REQUIRE_FALSE(accepts(hubs, int32_t(-1))); // hub outside the graph
+    REQUIRE_FALSE(accepts(hubs + 4, int32_t(n)));
+    REQUIRE_FALSE(accepts(outOffsets, uint64_t(1))); // offsets not starting at 0
+    REQUIRE_FALSE(accepts(outOffsets + 8, uint64_t(labels.labelEntries()))); // offsets decreasing or past the end
+    REQUIRE_FALSE(accepts(inOffsets + n * 8, uint64_t(0))); // offsets not ending at the entry count
+    REQUIRE_FALSE(accepts(outLabels, int32_t(n))); // an entry's hub rank outside the graph
+    REQUIRE_FALSE(accepts(outLabels + 4, int32_t(n))); // an entry's parent outside the graph
+    REQUIRE_FALSE(accepts(outLabels + 4, int32_t(-2)));
+
+    // a truncated file is rejected when loaded too
+    ofstream out("hub_labels_test.bin", ios::binary);
+    out.write((const char*)contents.data(), labels.bytes() - 16);
+    out.close();
+    HubLabels loaded;
+    REQUIRE_FALSE(loaded.load("hub_labels_test.bin", g));
+    remove("hub_labels_test.bin");
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "RadixHeap.h"
+#include "IntegerGraph.h"
+#include "Algorithms/dijkstra.h"
+
+#include <random>
+#include <algorithm>
+
+using namespace std;
+
+TEST_CASE("Radix Heap Pops In Order") {
+    RadixHeap heap;
+    mt19937 generator(3);
+    uniform_int_distribution<int> step(0, 5000);
+    vector<uint64_t> popped;
+    uint64_t last = 0;
+    // interleaves pushes and pops, always pushing keys at least the last key popped
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 10; i++) {
+            heap.push(last + step(generator), i);
+        }
+        for (int i = 0; i < 7; i++) {
+            last = heap.pop().first;
+            popped.push_back(last);
+        }
+    }
+    REQUIRE(heap.size() == 600);
+    while (!heap.empty()) {
+        popped.push_back(heap.pop().first);
+    }
+    REQUIRE(popped.size() == 2000);
+    REQUIRE(is_sorted(popped.begin(), popped.end()));
+
+    heap.clear();
+    REQUIRE(heap.empty());
+    heap.push(7, 1);
+    heap.push(3, 2);
+    REQUIRE(heap.pop() == make_pair((uint64_t)3, 2));
+}
+
+TEST_CASE("Rounding Metres") {
+    REQUIRE(IntegerGraph::toMetres(0) == 0);
+    REQUIRE(IntegerGraph::toMetres(1.2344) == 1234);
+    REQUIRE(IntegerGraph::toMetres(1.2345) == 1235);
+    REQUIRE(IntegerGraph::toMetres(1e10) == 4294967295u);
+}
+
+TEST_CASE("Integer Dijkstra Within Rounding Bound") {
+    Graph g = syntheticData(400);
+    IntegerGraph ig(g);
+    REQUIRE(ig.matches(g.csr()));
+    REQUIRE(ig.edges() == g.csr().edges());
+
+    vector<int> ids = g.getIDs();
+    Dijkstras exact, rounded;
+    for (size_t i = 0; i < 60; i++) {
+        int source = ids[i * 5], target = ids[ids.size() - 1 - i * 3];
+        vector<int> expected = exact.getPath(g, source, target);
+        vector<int> path = rounded.getPath(ig, source, target);
+        REQUIRE(path.empty() == expected.empty());
+        if (path.empty()) { continue; }
+        REQUIRE(path.front() == source);
+        REQUIRE(path.back() == target);
+
+        double length = 0;
+        for (size_t j = 1; j < path.size(); j++) { length += g.getDistance(path[j - 1], path[j]); }
+        // the rounded distance is within half a metre per connection of the path's true length, and the
+        // path is within half a metre per connection on either path of the true shortest distance
+        int legs = path.size() - 1, shortestLegs = expected.size() - 1;
+        REQUIRE(abs(rounded.shortestDistance() - length) <= IntegerGraph::MAX_ROUNDING_ERROR * legs + 1e-9);
+        REQUIRE(length - exact.shortestDistance() <= IntegerGraph::MAX_ROUNDING_ERROR * (legs + shortestLegs) + 1e-9);
+    }
+
+    Graph small(false);
+    small.addNode(1, "one", 0, 0);
+    small.addNode(2, "two", 0, 1);
+    small.addNode(3, "three", 0, 2);
+    small.connect(1, 2);
+    small.connect(2, 3);
+    IntegerGraph smallRounded(small);
+    REQUIRE(rounded.getPath(smallRounded, 1, 3) == vector<int>({1, 2, 3}));
+    REQUIRE(rounded.shortestDistance() == 2);
+    REQUIRE(rounded.getPath(smallRounded, 3, 1).empty());
+    REQUIRE(rounded.getPath(smallRounded, 1, 9).empty());
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/k_shortest_paths.h"
+#include "Algorithms/dijkstra.h"
+
+#include <random>
+#include <set>
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+/**
+* @brief Checks that paths are distinct, loopless, use real connections, and are in order of their distances
+*
+* @param g The graph
+* @param paths The paths
+* @param distances The paths' distances
+* @param source The source ID
+* @param target The target ID
+*/
+static void checkPaths(const Graph& g, const vector<vector<int>>& paths, const vector<double>& distances, int source, int target) {
+    REQUIRE(paths.size() == distances.size());
+    set<vector<int>> distinct(paths.begin(), paths.end());
+    REQUIRE(distinct.size() == paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        REQUIRE(paths[i].front() == source);
+        REQUIRE(paths[i].back() == target);
+        set<int> airports(paths[i].begin(), paths[i].end());
+        REQUIRE(airports.size() == paths[i].size());
+        double length = 0;
+        for (size_t j = 1; j < paths[i].size(); j++) {
+            REQUIRE(g.connectedTo(paths[i][j - 1], paths[i][j]));
+            length += g.getDistance(paths[i][j - 1], paths[i][j]);
+        }
+        REQUIRE(abs(length - distances[i]) < 1e-6);
+        if (i > 0) { REQUIRE(distances[i - 1] <= distances[i] + 1e-9); }
+    }
+}
+
+TEST_CASE("Simple K Shortest Paths") {
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 1, 0);
+    g.addNode(4, "four", 1, 1);
+    g.addNode(5, "five", 5, 5);
+    g.connect(1, 2);
+    g.connect(1, 3);
+    g.connect(2, 4);
+    g.connect(3, 4);
+    g.connect(1, 4);
+    g.connect(2, 3);
+
+    KShortestPaths ksp;
+    vector<vector<int>> paths = ksp.getPaths(g, 1, 4, 10);
+    REQUIRE(paths.size() == 4);
+    REQUIRE(paths[0] == vector<int>({1, 4}));
+    checkPaths(g, paths, ksp.getDistances(), 1, 4);
+    REQUIRE(paths[3] == vector<int>({1, 2, 3, 4}));
+
+    REQUIRE(ksp.getPaths(g, 1, 5, 3).empty());
+    REQUIRE(ksp.getPaths(g, 1, 9, 3).empty());
+    REQUIRE(ksp.getPaths(g, 1, 4, 0).empty());
+    REQUIRE(ksp.getPaths(g, 1, 1, 3) == vector<vector<int>>({{1}}));
+}
+
+TEST_CASE("K Shortest Paths Match Brute Force") {
+    mt19937 generator(5);
+    for (int trial = 0; trial < 20; trial++) {
+        Graph g(true);
+        for (int id = 0; id < 9; id++) {
+            g.addNode(id, to_string(id), uniform_real_distribution<double>(-60, 60)(generator),
+                uniform_real_distribution<double>(-180, 180)(generator));
+        }
+        for (int i = 0; i < 25; i++) {
+            int a = generator() % 9, b = generator() % 9;
+            if (a != b) { g.connect(a, b); }
+        }
+
+        // every simple path from 0 to 8 by depth-first search
+        vector<double> all;
+        vector<bool> onPath(9, false);
+        function<void(int, double)> search = [&](int v, double distance) {
+            if (v == 8) {
+                all.push_back(distance);
+                return;
+            }
+            onPath[v] = true;
+            for (int adj : g.getConnections(v)) {
+                if (!onPath[adj]) { search(adj, distance + g.getDistance(v, adj)); }
+            }
+            onPath[v] = false;
+        };
+        search(0, 0);
+        sort(all.begin(), all.end());
+
+        for (int threads : {1, 3}) {
+            KShortestPaths ksp;
+            vector<vector<int>> paths = ksp.getPaths(g, 0, 8, 10, threads);
+            REQUIRE(paths.size() == min((size_t)10, all.size()));
+            checkPaths(g, paths, ksp.getDistances(), 0, 8);
+            for (size_t i = 0; i < paths.size(); i++) {
+                REQUIRE(abs(ksp.getDistances()[i] - all[i]) < 1e-6);
+            }
+        }
+    }
+}
+
+TEST_CASE("K Shortest Paths On Airports") {
+    vector<int> sub = {3830, 1382, 4049, 1002, 8336, 1003, 4105, 1004, 1059, 5662, 5663,
+        5664, 13762, 963, 966, 1013, 5613, 799, 1074, 248, 3797, 3576};
+    Graph g = readData("../Data/airports.dat", "../Data/routes.dat", sub);
+    KShortestPaths ksp;
+    vector<vector<int>> paths = ksp.getPaths(g, 3830, 4105, 10);
+    REQUIRE(!paths.empty());
+    checkPaths(g, paths, ksp.getDistances(), 3830, 4105);
+    Dijkstras dij;
+    REQUIRE(paths[0] == dij.getPath(g, 3830, 4105));
+}
+
+TEST_CASE("K Shortest Paths Avoiding Airports") {
+    // a masked query must find the same paths as a query on a copy with the airports removed
+    mt19937 generator(11);
+    for (int trial = 0; trial < 20; trial++) {
+        Graph g(true);
+        for (int id = 0; id < 9; id++) {
+            g.addNode(id, to_string(id), uniform_real_distribution<double>(-60, 60)(generator),
+                uniform_real_distribution<double>(-180, 180)(generator));
+        }
+        for (int i = 0; i < 30; i++) {
+            int a = generator() % 9, b = generator() % 9;
+            if (a != b) { g.connect(a, b); }
+        }
+
+        SearchMask mask;
+        mask.clear(g.csr());
+        Graph removed = g;
+        int closed = 1 + generator() % 7;
+        mask.banAirport(g.csr(), closed);
+        removed.removeNode(closed);
+        vector<int> out = removed.getConnections(0);
+        if (!out.empty()) {
+            REQUIRE(mask.banRoute(g.csr(), 0, out[0]));
+            removed.disconnect(0, out[0]);
+        }
+
+        KShortestPaths masked, copied;
+        vector<vector<int>> paths = masked.getPaths(g, 0, 8, 6, 2, &mask);
+        REQUIRE(paths == copied.getPaths(removed, 0, 8, 6, 2));
+        checkPaths(removed, paths, masked.getDistances(), 0, 8);
+    }
+    KShortestPaths ksp;
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.connect(1, 2);
+    SearchMask mask;
+    mask.clear(g.csr());
+    mask.banAirport(g.csr(), 2);
+    REQUIRE(ksp.getPaths(g, 1, 2, 3, 1, &mask).empty());
+}
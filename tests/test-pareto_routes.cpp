@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/pareto_routes.h"
+#include "Algorithms/hop_limited.h"
+
+#include <random>
+#include <limits>
+#include <functional>
+
+using namespace std;
+
+TEST_CASE("Simple Pareto Routes") {
+    /*
+        |1| -> |2| -> |3| -> |4|
+         \____ |5| _________/^   (through 5 is fewer legs but longer)
+    */
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 0, 2);
+    g.addNode(4, "four", 0, 3);
+    g.addNode(5, "five", 9, 9);
+    g.connect(1, 2);
+    g.connect(2, 3);
+    g.connect(3, 4);
+    g.connect(1, 5);
+    g.connect(5, 4);
+
+    ParetoRoutes pareto;
+    REQUIRE(pareto.getFront(g, 1, 4) == vector<vector<int>>({{1, 2, 3, 4}, {1, 5, 4}}));
+    REQUIRE(pareto.getDistances()[0] == 3);
+    REQUIRE(pareto.getLegs() == vector<int>({3, 2}));
+
+    // a direct flight that is also the shortest leaves a front of one
+    g.connect(1, 4);
+    REQUIRE(pareto.getFront(g, 1, 4) == vector<vector<int>>({{1, 4}}));
+    REQUIRE(pareto.getLegs() == vector<int>({1}));
+
+    REQUIRE(pareto.getFront(g, 1, 4, 0).empty());
+    REQUIRE(pareto.getFront(g, 4, 1).empty());
+    REQUIRE(pareto.getFront(g, 1, 42).empty());
+    REQUIRE(pareto.getFront(g, 2, 2) == vector<vector<int>>({{2}}));
+}
+
+TEST_CASE("Pareto Routes Match Brute Force") {
+    mt19937 generator(9);
+    for (int trial = 0; trial < 30; trial++) {
+        Graph g(true);
+        for (int id = 0; id < 9; id++) {
+            g.addNode(id, to_string(id), uniform_real_distribution<double>(-60, 60)(generator),
+                uniform_real_distribution<double>(-180, 180)(generator));
+        }
+        for (int i = 0; i < 28; i++) {
+            int a = generator() % 9, b = generator() % 9;
+            if (a != b) { g.connect(a, b); }
+        }
+
+        // the shortest simple path from 0 to 8 with each exact number of legs, then its non-dominated entries
+        const int maxLegs = 5;
+        vector<double> best(maxLegs + 1, numeric_limits<double>::infinity());
+        vector<bool> onPath(9, false);
+        function<void(int, double, int)> search = [&](int v, double distance, int legs) {
+            if (v == 8) {
+                best[legs] = min(best[legs], distance);
+                return;
+            }
+            if (legs == maxLegs) { return; }
+            onPath[v] = true;
+            for (int adj : g.getConnections(v)) {
+                if (!onPath[adj]) { search(adj, distance + g.getDistance(v, adj), legs + 1); }
+            }
+            onPath[v] = false;
+        };
+        search(0, 0, 0);
+        vector<pair<double, int>> expected;
+        double shortest = numeric_limits<double>::infinity();
+        for (int legs = 0; legs <= maxLegs; legs++) {
+            if (best[legs] < shortest) {
+                shortest = best[legs];
+                expected.insert(expected.begin(), make_pair(best[legs], legs));
+            }
+        }
+
+        ParetoRoutes pareto;
+        vector<vector<int>> front = pareto.getFront(g, 0, 8, maxLegs);
+        REQUIRE(front.size() == expected.size());
+        for (size_t i = 0; i < front.size(); i++) {
+            REQUIRE(abs(pareto.getDistances()[i] - expected[i].first) < 1e-6);
+            REQUIRE(pareto.getLegs()[i] == expected[i].second);
+            REQUIRE((int)front[i].size() == expected[i].second + 1);
+            double length = 0;
+            for (size_t j = 1; j < front[i].size(); j++) {
+                REQUIRE(g.connectedTo(front[i][j - 1], front[i][j]));
+                length += g.getDistance(front[i][j - 1], front[i][j]);
+            }
+            REQUIRE(abs(length - pareto.getDistances()[i]) < 1e-6);
+        }
+    }
+}
+
+TEST_CASE("Pareto Routes Match Hop Limited Paths") {
+    // the front's entry with the most legs up to k is the shortest path with at most k legs
+    Graph g = syntheticData(500);
+    vector<int> ids = g.getIDs();
+    ParetoRoutes pareto;
+    HopLimitedPaths hops;
+    for (size_t i = 0; i < 10; i++) {
+        int source = ids[i * 37], target = ids[ids.size() - 1 - i * 41];
+        pareto.getFront(g, source, target, 5);
+        hops.build(g, source, 5);
+        for (int k = 0; k <= 5; k++) {
+            double expected = numeric_limits<double>::infinity();
+            for (size_t j = 0; j < pareto.getLegs().size(); j++) {
+                if (pareto.getLegs()[j] <= k) { expected = min(expected, pareto.getDistances()[j]); }
+            }
+            double distance = hops.getDistance(target, k);
+            REQUIRE((distance == expected || abs(distance - expected) < 1e-6));
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/range_queries.h"
+#include "Algorithms/hop_limited.h"
+#include "Algorithms/shortest_paths.h"
+#include "Algorithms/bfs.h"
+
+#include <limits>
+#include <map>
+
+using namespace std;
+
+TEST_CASE("Simple Range Queries") {
+    /*
+        |1| -> |2| -> |3| -> |4|
+         \_______________^          (1 -> 3 directly is 2.5 long)
+    */
+    Graph g(false);
+    g.addNode(1, "one", 0, 0);
+    g.addNode(2, "two", 0, 1);
+    g.addNode(3, "three", 0, 2);
+    g.addNode(4, "four", 0, 3);
+    g.connect(1, 2);
+    g.connect(2, 3);
+    g.connect(3, 4);
+    g.addNode(5, "five", 0, 2.5);
+    g.connect(1, 5);
+
+    vector<ReachableAirport> reached = reachableWithin(g, 1, 2);
+    REQUIRE(reached.size() == 3);
+    REQUIRE(reached[0].id == 1);
+    REQUIRE(reached[0].legs == 0);
+    REQUIRE(reached[1].id == 2);
+    REQUIRE(reached[2].id == 3);
+    REQUIRE(reached[2].distance == 2);
+    REQUIRE(reached[2].legs == 2);
+    REQUIRE(reachableWithin(g, 1, 10).size() == 5);
+    REQUIRE(reachableWithin(g, 4, 10).size() == 1);
+    REQUIRE(reachableWithin(g, 42, 10).empty());
+
+    reached = reachableWithinLegs(g, 1, 1);
+    REQUIRE(reached.size() == 3);
+    REQUIRE(reached[2].id == 5);
+    REQUIRE(reached[2].legs == 1);
+    REQUIRE(reachableWithinLegs(g, 1, 3, 2.5).size() == 4);
+
+    vector<vector<int>> bands = isochrones(g, 1, {1, 2, 3});
+    REQUIRE(bands == vector<vector<int>>({{1, 2}, {3}, {5, 4}}));
+}
+
+TEST_CASE("Range Queries Match Full Searches") {
+    Graph g = syntheticData(600);
+    const CSRGraph& csr = g.csr();
+    vector<int> ids = g.getIDs();
+    double inf = numeric_limits<double>::infinity();
+    for (size_t i = 0; i < ids.size(); i += 97) {
+        int source = ids[i];
+        vector<double> distances;
+        shortestDistances(csr, csr.getIndex(source), false, distances);
+
+        for (double budget : {0.0, 500.0, 2000.0, 8000.0}) {
+            map<int, double> expected;
+            for (int v = 0; v < csr.size(); v++) {
+                if (distances[v] <= budget) { expected[csr.getID(v)] = distances[v]; }
+            }
+            vector<ReachableAirport> reached = reachableWithin(g, source, budget);
+            REQUIRE(reached.size() == expected.size());
+            for (size_t j = 0; j < reached.size(); j++) {
+                REQUIRE(expected.count(reached[j].id));
+                REQUIRE(abs(reached[j].distance - expected[reached[j].id]) < 1e-6);
+                if (j > 0) { REQUIRE(reached[j - 1].distance <= reached[j].distance); }
+            }
+        }
+
+        HopLimitedPaths hops;
+        for (int legs : {0, 1, 2, 3}) {
+            hops.build(g, source, legs);
+            for (double budget : {inf, 3000.0}) {
+                map<int, double> expected;
+                for (int id : ids) {
+                    double distance = hops.getDistance(id, legs);
+                    if (distance < inf && distance <= budget) { expected[id] = distance; }
+                }
+                vector<ReachableAirport> reached = reachableWithinLegs(g, source, legs, budget);
+                REQUIRE(reached.size() == expected.size());
+                for (const ReachableAirport& airport : reached) {
+                    REQUIRE(expected.count(airport.id));
+                    REQUIRE(abs(airport.distance - expected[airport.id]) < 1e-6);
+                    REQUIRE(airport.legs <= legs);
+                    REQUIRE((airport.legs == 0 || hops.getDistance(airport.id, airport.legs - 1) == inf));
+                }
+            }
+        }
+    }
+}
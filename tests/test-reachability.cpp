@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "readdat.h"
+#include "Algorithms/reachability.h"
+#include "Algorithms/shortest_paths.h"
+
+#include <vector>
+#include <random>
+#include <limits>
+
+using namespace std;
+
+/**
+* @brief Checks every pair of a graph against plain BFS from each airport
+*
+* @param g The graph
+* @param index The index built for g
+*/
+static void checkAllPairs(const Graph& g, const ReachabilityIndex& index) {
+    const CSRGraph& csr = g.csr();
+    int n = csr.size();
+    for (int s = 0; s < n; s++) {
+        vector<bool> reached(n, false);
+        vector<int> queue(1, s);
+        reached[s] = true;
+        for (size_t front = 0; front < queue.size(); front++) {
+            int u = queue[front];
+            for (int e = csr.outBegin(u); e < csr.outEnd(u); e++) {
+                if (!reached[csr.target(e)]) {
+                    reached[csr.target(e)] = true;
+                    queue.push_back(csr.target(e));
+                }
+            }
+        }
+        for (int t = 0; t < n; t++) {
+            REQUIRE(index.reachesIndex(s, t) == reached[t]);
+            REQUIRE(index.reaches(csr.getID(s), csr.getID(t)) == reached[t]);
+        }
+    }
+}
+
+TEST_CASE("Reachability Index Matches BFS On Random Graphs") {
+    mt19937 rng(42);
+    for (int round = 0; round < 60; round++) {
+        Graph g;
+        int n = 1 + rng() % 40;
+        for (int i = 1; i <= n; i++) { g.addNode(i * 2, "air", rng() % 90, rng() % 180); }
+        // mostly one-way connections, so the condensation has many components and crossing connections
+        int routes = rng() % (3 * n);
+        for (int i = 0; i < routes; i++) {
+            int from = 2 + rng() % n * 2, to = 2 + rng() % n * 2;
+            g.connect(from, to);
+            if (rng() % 8 == 0) { g.connect(to, from); }
+        }
+        ReachabilityIndex index;
+        index.build(g);
+        REQUIRE(index.matches(g.csr()));
+        REQUIRE(index.components() == g.csr().strongComponents());
+        checkAllPairs(g, index);
+    }
+}
+
+TEST_CASE("Reachability Index Unconnected") {
+
+    /*
+
+        |1|-------|2|          |6|----->|5|-------|7|
+                  /                      |
+                 /                       |
+                /                       |4|
+              |3|
+
+    */
+
+    Graph g;
+    for (int i = 1; i <= 7; i++) { g.addNode(i, "air", 0, i); }
+    g.connect(1,2);
+    g.connect(2,1);
+    g.connect(2,3);
+    g.connect(3,2);
+    g.connect(6,5);
+    g.connect(5,7);
+    g.connect(7,5);
+    g.connect(5,4);
+    g.connect(4,5);
+
+    ReachabilityIndex index;
+    REQUIRE(!index.reaches(1, 1));
+    index.build(g);
+    REQUIRE(index.components() == 3);
+    REQUIRE(index.reaches(1, 3));
+    REQUIRE(index.reaches(6, 4));
+    REQUIRE(!index.reaches(4, 6));
+    REQUIRE(!index.reaches(1, 5));
+    REQUIRE(index.reaches(6, 6));
+    REQUIRE(!index.reaches(1, 8));
+    REQUIRE(!index.reaches(8, 8));
+    checkAllPairs(g, index);
+
+    g.connect(4, 2);
+    REQUIRE(!index.matches(g.csr()));
+    index.build(g);
+    REQUIRE(index.reaches(6, 3));
+    REQUIRE(!index.reaches(1, 5));
+}
+
+TEST_CASE("Reachability Index On OpenFlights") {
+    Graph g = readData("../Data/airports.dat", "../Data/routes.dat");
+    const CSRGraph& csr = g.csr();
+    ReachabilityIndex index;
+    index.build(g);
+    // labels stay small: about one interval per component
+    REQUIRE(index.intervals() < 2 * (size_t)index.components());
+
+    mt19937 rng(3);
+    vector<double> distances;
+    for (int i = 0; i < 30; i++) {
+        int s = rng() % csr.size();
+        shortestDistances(csr, s, false, distances);
+        for (int t = 0; t < csr.size(); t++) {
+            REQUIRE(index.reachesIndex(s, t) == (distances[t] != numeric_limits<double>::infinity()));
+        }
+    }
+}